@@ -0,0 +1,70 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Compares the batch math extension against element-wise JS loops over the
+// same Float64Array and Float32Array data. Each kernel is timed separately
+// and printed, so the native and JS versions can be compared within one
+// run; d8 --bench times the whole script.
+//
+//   d8 --bench --expose-batch-math benchmarks/batch-math.js
+
+var kLength = 1 << 16;
+var kRepeat = 20;
+
+function Fill(array) {
+  for (var i = 0; i < array.length; i++) array[i] = (i % 1000) / 100 - 5;
+}
+
+function JSLoop(fn, src, dst) {
+  for (var i = 0; i < src.length; i++) dst[i] = fn(src[i]);
+  return dst;
+}
+
+function Time(name, body) {
+  var start = Date.now();
+  for (var i = 0; i < kRepeat; i++) body();
+  print(name + ": " + (Date.now() - start) + " ms");
+}
+
+var kFunctions = [
+  ["sin", Math.sin, Math.sinArray],
+  ["cos", Math.cos, Math.cosArray],
+  ["exp", Math.exp, Math.expArray],
+  ["sqrt", Math.sqrt, Math.sqrtArray]
+];
+var kTypes = [["Float64Array", Float64Array], ["Float32Array", Float32Array]];
+
+kTypes.forEach(function(type) {
+  var src = new type[1](kLength);
+  var dst = new type[1](kLength);
+  Fill(src);
+  kFunctions.forEach(function(fn) {
+    var label = fn[0] + " " + type[0];
+    Time(label + " JS loop", function() { JSLoop(fn[1], src, dst); });
+    Time(label + " batch", function() { fn[2](src, dst); });
+  });
+});
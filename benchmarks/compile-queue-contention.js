@@ -0,0 +1,56 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Makes hundreds of distinct functions hot at about the same time, so that
+// the main thread keeps handing optimization jobs to the concurrent
+// compiler thread and taking the results back through its queues. Running
+// with --prof adds the hand-off between the sampler and the profiler
+// event processor thread. Compare against --noconcurrent-recompilation to
+// see the cost of the hand-offs themselves.
+//
+//   d8 --bench benchmarks/compile-queue-contention.js
+//   d8 --bench --prof benchmarks/compile-queue-contention.js
+//   d8 --bench --noconcurrent-recompilation \
+//       benchmarks/compile-queue-contention.js
+
+var kFunctions = 400;
+var kRounds = 2000;
+
+// Every function has its own source, so each needs its own optimization.
+var functions = [];
+for (var i = 0; i < kFunctions; i++) {
+  functions.push(new Function("a", "b",
+      "var sum = " + i + ";" +
+      "for (var j = 0; j < 10; j++) sum += (a * j + b) % " + (i + 7) + ";" +
+      "return sum;"));
+}
+
+var total = 0;
+for (var round = 0; round < kRounds; round++) {
+  for (var i = 0; i < kFunctions; i++) total += functions[i](round, i);
+}
+if (!(total > 0)) throw new Error("bad total " + total);
@@ -0,0 +1,50 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Converts timestamps spread over 1970-2037 to local time, the way log
+// processing does. The timestamps come from a fixed linear congruential
+// sequence so that every run sees the same inputs. Consecutive lookups
+// almost never fall in the same daylight savings period.
+//
+//   d8 --bench benchmarks/date-local-time.js
+//   TZ=America/Los_Angeles d8 --bench benchmarks/date-local-time.js
+
+var kCount = 200000;
+var kMaxTime = 2145916800000;  // 2038-01-01T00:00:00Z.
+
+var seed = 42;
+function NextTime() {
+  seed = seed * 16807 % 2147483647;
+  return Math.floor(seed / 2147483647 * kMaxTime);
+}
+
+var hours = 0;
+for (var i = 0; i < kCount; i++) {
+  var date = new Date(NextTime());
+  hours += date.getHours();
+}
+if (!(hours >= 0 && hours <= 23 * kCount)) throw new Error("bad hours");
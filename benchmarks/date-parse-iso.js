@@ -0,0 +1,72 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Parses timestamps in the strict YYYY-MM-DDTHH:mm:ss.sssZ form, the way
+// JSON data carries them, and a smaller share of strings in other forms
+// that still go through the general parser. The strings are built before
+// parsing starts, so only Date.parse is measured.
+//
+//   d8 --bench benchmarks/date-parse-iso.js
+
+var kCount = 200000;
+
+function Pad(value, width) {
+  var string = "" + value;
+  while (string.length < width) string = "0" + string;
+  return string;
+}
+
+var seed = 11;
+function Next(limit) {
+  seed = seed * 16807 % 2147483647;
+  return seed % limit;
+}
+
+function MakeStrings() {
+  var strings = [];
+  for (var i = 0; i < kCount; i++) {
+    var date = Pad(1970 + Next(68), 4) + "-" + Pad(1 + Next(12), 2) + "-" +
+               Pad(1 + Next(28), 2);
+    var time = Pad(Next(24), 2) + ":" + Pad(Next(60), 2) + ":" +
+               Pad(Next(60), 2);
+    switch (i % 8) {
+      case 0: strings.push(date); break;
+      case 1: strings.push(date + "T" + time + "+01:00"); break;
+      case 2: strings.push(date + "T" + time + "Z"); break;
+      default: strings.push(date + "T" + time + "." + Pad(Next(1000), 3) + "Z");
+    }
+  }
+  return strings;
+}
+
+var strings = MakeStrings();
+var sum = 0;
+for (var i = 0; i < strings.length; i++) {
+  var time = Date.parse(strings[i]);
+  if (time !== time) throw new Error("cannot parse " + strings[i]);
+  sum += time;
+}
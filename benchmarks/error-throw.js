@@ -0,0 +1,51 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Throws and catches many errors from a few frames deep, the way promise
+// rejections and parser errors do. Most of the errors are dropped without
+// their stack being read, so the run time is dominated by capturing the
+// raw stack trace. Every hundredth error has its stack formatted.
+//
+//   d8 --bench benchmarks/error-throw.js
+//   d8 --bench --stack-trace-limit=0 benchmarks/error-throw.js
+
+var kThrows = 100000;
+var kFormatEvery = 100;
+
+function Fail(i) { throw new Error("failure " + i); }
+function Middle(i) { return Fail(i); }
+function Outer(i) { return Middle(i); }
+
+var formatted = 0;
+for (var i = 0; i < kThrows; i++) {
+  try {
+    Outer(i);
+  } catch (e) {
+    if (i % kFormatEvery == 0 && e.stack.length > 0) formatted++;
+  }
+}
+if (formatted != kThrows / kFormatEvery) throw new Error("lost stacks");
@@ -0,0 +1,55 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Creates 100k external strings, drops them and collects them with a full
+// GC, which is the pause that processes the external string table. The
+// resources of the dead strings are disposed right after that GC once more
+// than 1024 of them are queued. Compare the mark-compact pauses reported
+// by --trace-gc, or the V8.GCCompactor histogram with --dump-counters.
+//
+//   d8 --bench --expose-gc --expose-externalize-string --trace-gc \
+//       benchmarks/external-strings.js
+
+var kCount = 100000;
+var kPrefix = "an external string that is long enough to be worth it #";
+
+function MakeExternalStrings() {
+  var strings = new Array(kCount);
+  for (var i = 0; i < kCount; i++) {
+    var string = kPrefix + i;
+    externalizeString(string, false);
+    strings[i] = string;
+  }
+  return strings;
+}
+
+var strings = MakeExternalStrings();
+var total = 0;
+for (var i = 0; i < strings.length; i++) total += strings[i].length;
+if (total < kCount * kPrefix.length) throw new Error("lost strings");
+strings = null;
+gc();
@@ -0,0 +1,73 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Variadic call microbenchmarks: forwarding arguments with apply, applying
+// small and large arrays, arrays with holes, and call with a fixed count.
+// Each case is timed separately and printed; d8 --bench times the whole
+// script. Running with --nocrankshaft keeps everything on the apply
+// builtin instead of the optimized HApplyArguments path.
+//
+//   d8 --bench benchmarks/function-apply.js
+//   d8 --bench --nocrankshaft benchmarks/function-apply.js
+
+var kIterations = 1000000;
+
+function Sum() {
+  var sum = 0;
+  for (var i = 0; i < arguments.length; i++) sum += arguments[i] | 0;
+  return sum;
+}
+
+function Forward() { return Sum.apply(this, arguments); }
+function Log(a, b, c) { return Forward.apply(this, arguments); }
+
+var small = [1, 2, 3, 4];
+var large = [];
+for (var i = 0; i < 200; i++) large.push(i);
+var holey = [1, , 3, , 5];
+var objects = [{}, {}, {}, {}];
+
+function Time(name, expected, iterations, body) {
+  var start = Date.now();
+  var result = 0;
+  for (var i = 0; i < iterations; i++) result = body();
+  print(name + ": " + (Date.now() - start) + " ms");
+  if (result !== expected) throw new Error(name + " returned " + result);
+}
+
+Time("forward arguments", 6, kIterations,
+     function() { return Log(1, 2, 3); });
+Time("apply small array", 10, kIterations,
+     function() { return Sum.apply(null, small); });
+Time("apply large array", 19900, kIterations / 20,
+     function() { return Sum.apply(null, large); });
+Time("apply holey array", 9, kIterations,
+     function() { return Sum.apply(null, holey); });
+Time("apply object array", 0, kIterations,
+     function() { return Sum.apply(null, objects); });
+Time("call", 10, kIterations,
+     function() { return Sum.call(null, 1, 2, 3, 4); });
@@ -0,0 +1,59 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Grows large arrays one element at a time, so that their backing stores
+// keep outgrowing their large object pages. With --large-object-headroom
+// (the default) the stores grow in place; --large-object-headroom=0 makes
+// every growth step allocate a new store and copy the elements.
+//
+//   d8 --bench benchmarks/large-array-growth.js
+//   d8 --bench --large-object-headroom=0 benchmarks/large-array-growth.js
+
+var kLength = 4 * 1024 * 1024;
+
+function GrowSmiArray() {
+  var array = [];
+  for (var i = 0; i < kLength; i++) array.push(i);
+  return array;
+}
+
+function GrowDoubleArray() {
+  var array = [];
+  for (var i = 0; i < kLength; i++) array.push(i + 0.5);
+  return array;
+}
+
+function GrowObjectArray() {
+  var array = [];
+  var object = {};
+  for (var i = 0; i < kLength; i++) array.push(object);
+  return array;
+}
+
+var lengths = GrowSmiArray().length + GrowDoubleArray().length +
+              GrowObjectArray().length;
+if (lengths != 3 * kLength) throw new Error("unexpected length " + lengths);
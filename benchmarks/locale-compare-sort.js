@@ -0,0 +1,76 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Sorts 100k strings with localeCompare, once with the default locale and
+// once each for German and Japanese, the way a multilingual UI sorts its
+// lists. The ASCII word list takes the path that compares without ICU where
+// the locale allows it; the accented list always goes through ICU. Needs a
+// d8 built with i18n support.
+//
+//   d8 --bench benchmarks/locale-compare-sort.js
+
+var kCount = 100000;
+var kLetters = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+var kAccented = "aàbcçdeéèfghiïjklmnñoöpqrsßtuüvwxyz";
+
+var seed = 7;
+function Next(limit) {
+  seed = seed * 16807 % 2147483647;
+  return seed % limit;
+}
+
+function MakeWords(alphabet) {
+  var words = [];
+  for (var i = 0; i < kCount; i++) {
+    var word = "";
+    var length = 3 + Next(10);
+    for (var j = 0; j < length; j++) word += alphabet[Next(alphabet.length)];
+    words.push(word);
+  }
+  return words;
+}
+
+function Sort(words, locale) {
+  var sorted = words.slice();
+  if (locale === undefined) {
+    sorted.sort(function(a, b) { return a.localeCompare(b); });
+  } else {
+    sorted.sort(function(a, b) { return a.localeCompare(b, locale); });
+  }
+  for (var i = 1; i < sorted.length; i++) {
+    if (sorted[i - 1].localeCompare(sorted[i], locale) > 0) {
+      throw new Error("not sorted at " + i);
+    }
+  }
+}
+
+var ascii = MakeWords(kLetters);
+var accented = MakeWords(kAccented);
+[undefined, "de", "ja"].forEach(function(locale) {
+  Sort(ascii, locale);
+  Sort(accented, locale);
+});
@@ -0,0 +1,71 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Fills Maps and Sets with Smi keys, short string keys and long string
+// keys built at run time, then looks every key up again from optimized
+// code. Long strings that have no internalized copy are stored as they
+// are, so their lookups go through the runtime.
+//
+//   d8 --bench --harmony-collections benchmarks/map-set.js
+
+var kCount = 10000;
+var kLookups = 20;
+var kLongPrefix = "a string key that is too long to internalize ";
+
+function MakeKeys() {
+  var keys = [];
+  for (var i = 0; i < kCount; i++) {
+    keys.push(i);
+    keys.push("k" + i);
+    keys.push(kLongPrefix + i);
+  }
+  return keys;
+}
+
+function Fill(map, set, keys) {
+  for (var i = 0; i < keys.length; i++) {
+    map.set(keys[i], i);
+    set.add(keys[i]);
+  }
+}
+
+function Lookup(map, set, keys) {
+  var found = 0;
+  for (var i = 0; i < keys.length; i++) {
+    if (map.get(keys[i]) === i && set.has(keys[i])) found++;
+  }
+  return found;
+}
+
+var keys = MakeKeys();
+var map = new Map();
+var set = new Set();
+Fill(map, set, keys);
+for (var i = 0; i < kLookups; i++) {
+  if (Lookup(map, set, keys) != keys.length) throw new Error("missing key");
+}
+for (var i = 0; i < keys.length; i++) map.delete(keys[i]);
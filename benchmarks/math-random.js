@@ -0,0 +1,69 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Draws millions of values from Math.random, the way particle spawners do,
+// and runs a quick quality check on them: the mean, and a chi-square test
+// over 100 equal buckets. The check throws if the values are far from
+// uniform, so a broken generator cannot post a good time.
+//
+//   d8 --bench benchmarks/math-random.js
+
+var kDraws = 4000000;
+var kBuckets = 100;
+// The 0.9999 quantile of the chi-square distribution with 99 degrees of
+// freedom.
+var kChiSquareLimit = 157.4;
+
+function Draw() {
+  var buckets = new Int32Array(kBuckets);
+  var sum = 0;
+  for (var i = 0; i < kDraws; i++) {
+    var value = Math.random();
+    if (!(value >= 0 && value < 1)) throw new Error("out of range: " + value);
+    sum += value;
+    buckets[Math.floor(value * kBuckets)]++;
+  }
+  return { sum: sum, buckets: buckets };
+}
+
+var result = Draw();
+
+var mean = result.sum / kDraws;
+// Six standard deviations of the mean of kDraws uniform values.
+if (Math.abs(mean - 0.5) > 6 * Math.sqrt(1 / 12 / kDraws)) {
+  throw new Error("mean is off: " + mean);
+}
+
+var expected = kDraws / kBuckets;
+var chi_square = 0;
+for (var i = 0; i < kBuckets; i++) {
+  var delta = result.buckets[i] - expected;
+  chi_square += delta * delta / expected;
+}
+if (chi_square > kChiSquareLimit) {
+  throw new Error("not uniform, chi-square " + chi_square);
+}
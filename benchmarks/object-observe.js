@@ -0,0 +1,67 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Observes a few thousand objects and updates every one of them several
+// times per "frame", the way a data-binding layer does. Half of the
+// objects are observed only for "add", so their "update" records are never
+// delivered. Records are flushed with Object.deliverChangeRecords after
+// each frame.
+//
+//   d8 --bench benchmarks/object-observe.js
+
+var kObjects = 2000;
+var kFrames = 50;
+var kUpdatesPerFrame = 4;
+
+var delivered = 0;
+function Observer(records) { delivered += records.length; }
+
+var objects = [];
+for (var i = 0; i < kObjects; i++) {
+  var object = { x: 0, y: 0 };
+  if (i % 2 == 0) {
+    Object.observe(object, Observer);
+  } else {
+    Object.observe(object, Observer, ["add"]);
+  }
+  objects.push(object);
+}
+
+for (var frame = 0; frame < kFrames; frame++) {
+  for (var i = 0; i < kObjects; i++) {
+    var object = objects[i];
+    for (var j = 0; j < kUpdatesPerFrame; j++) {
+      object.x = frame * kUpdatesPerFrame + j + 1;
+      object.y = -object.x;
+    }
+  }
+  Object.deliverChangeRecords(Observer);
+}
+
+var expected = (kObjects / 2) * kFrames * kUpdatesPerFrame * 2;
+if (delivered != expected) throw new Error("delivered " + delivered);
+for (var i = 0; i < kObjects; i++) Object.unobserve(objects[i], Observer);
@@ -0,0 +1,76 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Message-passing throughput between the main thread and a Worker. The
+// worker echoes everything it receives. Three kinds of messages make the
+// round trip: small objects that are cloned, 64KB ArrayBuffers that are
+// cloned, and 64KB ArrayBuffers that are transferred. Each kind is timed
+// separately and printed; d8 --bench times the whole script.
+//
+//   d8 --bench benchmarks/worker-messages.js
+
+var kMessages = 20000;
+var kBufferMessages = 2000;
+var kBufferSize = 64 * 1024;
+
+var worker = new Worker(
+    "onmessage = function(message) {" +
+    "  if (message instanceof ArrayBuffer) {" +
+    "    postMessage(message, [message]);" +
+    "  } else {" +
+    "    postMessage(message);" +
+    "  }" +
+    "};");
+
+function Time(name, count, body) {
+  var start = Date.now();
+  for (var i = 0; i < count; i++) body(i);
+  var elapsed = Date.now() - start;
+  print(name + ": " + elapsed + " ms, " +
+        Math.round(count / Math.max(elapsed, 1) * 1000) + " messages/s");
+}
+
+Time("small objects", kMessages, function(i) {
+  worker.postMessage({ id: i, name: "message", values: [i, i + 1] });
+  var reply = worker.getMessage();
+  if (reply.id !== i) throw new Error("out of order: " + reply.id);
+});
+
+Time("cloned buffers", kBufferMessages, function(i) {
+  worker.postMessage(new ArrayBuffer(kBufferSize));
+  var reply = worker.getMessage();
+  if (reply.byteLength !== kBufferSize) throw new Error("bad reply");
+});
+
+Time("transferred buffers", kBufferMessages, function(i) {
+  var buffer = new ArrayBuffer(kBufferSize);
+  worker.postMessage(buffer, [buffer]);
+  var reply = worker.getMessage();
+  if (reply.byteLength !== kBufferSize) throw new Error("bad reply");
+});
+
+worker.terminate();
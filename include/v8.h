@@ -1202,6 +1202,21 @@ class V8_EXPORT ScriptCompiler {
   static Local<Script> Compile(
       Isolate* isolate, Source* source,
       CompileOptions options = kNoCompileOptions);
+
+  /**
+   * Pre-parses a batch of independent scripts in parallel on the platform's
+   * background threads and attaches the result to each source as cached
+   * data. Sources that already carry cached data are left alone.
+   *
+   * The scripts are then compiled one by one with CompileUnbound or Compile
+   * (without kProduceDataToCache), which can skip over the bodies of lazily
+   * compiled functions. Syntax errors found while pre-parsing are reported
+   * when the script that contains them is compiled.
+   *
+   * \param sources Array of count sources.
+   */
+  static void PreParseInParallel(Isolate* isolate, int count,
+                                 Source** sources);
 };
 
 
@@ -2771,6 +2786,16 @@ class V8_EXPORT ArrayBuffer : public Object {
      * That memory is guaranteed to be previously allocated by |Allocate|.
      */
     virtual void Free(void* data, size_t length) = 0;
+
+    /**
+     * Creates the allocator provided by V8. Small blocks are recycled
+     * through per-thread caches, large blocks are mapped directly from the
+     * OS. The caller owns the allocator and has to keep it alive until all
+     * isolates using it have been disposed. Memory parked in the caches and
+     * the rounding of small blocks to their size class are not included in
+     * the external memory that isolates account for.
+     */
+    static Allocator* NewDefaultAllocator();
   };
 
   /**
@@ -4052,6 +4077,9 @@ typedef void (*MemoryAllocationCallback)(ObjectSpace space,
 // --- Leave Script Callback ---
 typedef void (*CallCompletedCallback)();
 
+// --- Microtask Callback ---
+typedef void (*MicrotaskCallback)(void* data);
+
 // --- Failed Access Check Callback ---
 typedef void (*FailedAccessCheckCallback)(Local<Object> target,
                                           AccessType type,
@@ -4831,6 +4859,14 @@ class V8_EXPORT V8 {
    */
   static void EnqueueMicrotask(Isolate* isolate, Handle<Function> microtask);
 
+  /**
+   * Experimental: Enqueues a C++ callback to the Microtask Work Queue. It is
+   * run in order with the JavaScript microtasks and receives |data|.
+   */
+  static void EnqueueMicrotask(Isolate* isolate,
+                               MicrotaskCallback microtask,
+                               void* data = NULL);
+
    /**
    * Experimental: Controls whether the Microtask Work Queue is automatically
    * run when the script call depth decrements to zero.
@@ -615,7 +615,8 @@ MaybeObject* Accessors::FunctionSetPrototype(Isolate* isolate,
 
   if (is_observed && !old_value->SameValue(*value)) {
     JSObject::EnqueueChangeRecord(
-        function, "update", isolate->factory()->prototype_string(), old_value);
+        function, isolate->factory()->update_string(),
+        isolate->factory()->prototype_string(), old_value);
   }
 
   return *function;
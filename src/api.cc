@@ -32,6 +32,7 @@
 #include "../include/v8-debug.h"
 #include "../include/v8-profiler.h"
 #include "../include/v8-testing.h"
+#include "array-buffer-allocator.h"
 #include "assert-scope.h"
 #include "bootstrapper.h"
 #include "code-stubs.h"
@@ -1813,6 +1814,38 @@ Local<UnboundScript> ScriptCompiler::CompileUnbound(
 }
 
 
+void ScriptCompiler::PreParseInParallel(Isolate* v8_isolate,
+                                        int count,
+                                        Source** sources) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
+  ON_BAILOUT(isolate, "v8::ScriptCompiler::PreParseInParallel()", return);
+  LOG_API(isolate, "ScriptCompiler::PreParseInParallel");
+  ENTER_V8(isolate);
+  i::HandleScope scope(isolate);
+  i::List<Source*> pending(count);
+  i::List<i::Handle<i::String> > strings(count);
+  for (int i = 0; i < count; i++) {
+    if (sources[i]->cached_data != NULL) continue;
+    pending.Add(sources[i]);
+    // Flatten up front; the background threads must not allocate.
+    strings.Add(i::String::Flatten(
+        Utils::OpenHandle(*(sources[i]->source_string))));
+  }
+  if (pending.is_empty()) return;
+  i::ScopedVector<i::ScriptDataImpl*> results(pending.length());
+  i::PreParserApi::PreParseInParallel(isolate, strings.ToVector(), results);
+  for (int i = 0; i < pending.length(); i++) {
+    i::ScriptDataImpl* script_data_impl = results[i];
+    if (script_data_impl == NULL) continue;
+    pending[i]->cached_data = new CachedData(
+        reinterpret_cast<const uint8_t*>(script_data_impl->Data()),
+        script_data_impl->Length(), CachedData::BufferOwned);
+    script_data_impl->owns_store_ = false;
+    delete script_data_impl;
+  }
+}
+
+
 Local<Script> ScriptCompiler::Compile(
     Isolate* v8_isolate,
     Source* source,
@@ -5948,6 +5981,11 @@ Local<Promise> Promise::Catch(Handle<Function> handler) {
 }
 
 
+v8::ArrayBuffer::Allocator* v8::ArrayBuffer::Allocator::NewDefaultAllocator() {
+  return new i::PoolingArrayBufferAllocator();
+}
+
+
 bool v8::ArrayBuffer::IsExternal() const {
   return Utils::OpenHandle(this)->is_external();
 }
@@ -6523,7 +6561,22 @@ void V8::RunMicrotasks(Isolate* isolate) {
 void V8::EnqueueMicrotask(Isolate* isolate, Handle<Function> microtask) {
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
   ENTER_V8(i_isolate);
-  i::Execution::EnqueueMicrotask(i_isolate, Utils::OpenHandle(*microtask));
+  i_isolate->EnqueueMicrotask(Utils::OpenHandle(*microtask));
+}
+
+
+void V8::EnqueueMicrotask(Isolate* isolate,
+                          MicrotaskCallback microtask,
+                          void* data) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  ENTER_V8(i_isolate);
+  i::HandleScope scope(i_isolate);
+  i::Handle<i::CallHandlerInfo> callback_info =
+      i::Handle<i::CallHandlerInfo>::cast(
+          i_isolate->factory()->NewStruct(i::CALL_HANDLER_INFO_TYPE));
+  SET_FIELD_WRAPPED(callback_info, set_callback, microtask);
+  SET_FIELD_WRAPPED(callback_info, set_data, data);
+  i_isolate->EnqueueMicrotask(callback_info);
 }
 
 
@@ -7513,7 +7566,14 @@ namespace internal {
 
 
 void HandleScopeImplementer::FreeThreadResources() {
-  Free();
+  // All scopes are closed when the last Locker of a thread is released. The
+  // spare block and the list backing stores are kept for the next thread to
+  // take the lock. RestoreThread releases them if that thread brings its own
+  // archived state.
+  ASSERT(blocks_.length() == 0);
+  ASSERT(entered_contexts_.length() == 0);
+  ASSERT(saved_contexts_.length() == 0);
+  ASSERT(call_depth_ == 0);
 }
 
 
@@ -7535,7 +7595,18 @@ int HandleScopeImplementer::ArchiveSpacePerThread() {
 
 
 char* HandleScopeImplementer::RestoreThread(char* storage) {
+  // The current state is either archived and empty, or holds the buffers
+  // that FreeThreadResources kept. Release them before they are overwritten,
+  // but hand the spare block to the restored thread if it has none.
+  Object** spare = spare_;
+  spare_ = NULL;
+  Free();
   OS::MemCopy(this, storage, sizeof(*this));
+  if (spare_ == NULL) {
+    spare_ = spare;
+  } else {
+    DeleteArray(spare);
+  }
   *isolate_->handle_scope_data() = handle_scope_data_;
   return storage + ArchiveSpacePerThread();
 }
@@ -1350,8 +1350,52 @@ void Builtins::Generate_FunctionApply(MacroAssembler* masm) {
     __ bind(&push_receiver);
     __ push(r0);
 
-    // Copy all arguments from the array to the stack.
-    Label entry, loop;
+    // Copy all arguments from the array to the stack. Arrays and arguments
+    // objects with fast elements are copied straight from their backing store
+    // unless they contain holes, which need a lookup on the prototype chain.
+    Label entry, loop, slow_copy, check_elements_kind, copy_loop, copy_entry;
+    Label copy_hole, invoke;
+    __ ldr(r1, MemOperand(fp, kArgsOffset));
+    __ JumpIfSmi(r1, &slow_copy);
+    __ ldr(r2, FieldMemOperand(r1, HeapObject::kMapOffset));
+    __ ldrb(r3, FieldMemOperand(r2, Map::kBitFieldOffset));
+    __ tst(r3, Operand((1 << Map::kHasIndexedInterceptor) |
+                       (1 << Map::kIsAccessCheckNeeded)));
+    __ b(ne, &slow_copy);
+    __ CompareInstanceType(r2, r3, JS_ARRAY_TYPE);
+    __ b(eq, &check_elements_kind);
+    __ cmp(r3, Operand(JS_OBJECT_TYPE));
+    __ b(ne, &slow_copy);
+    __ bind(&check_elements_kind);
+    __ CheckFastElements(r2, r3, &slow_copy);
+    __ ldr(r2, FieldMemOperand(r1, JSObject::kElementsOffset));
+    __ ldr(r0, MemOperand(fp, kLimitOffset));
+    __ ldr(r3, FieldMemOperand(r2, FixedArray::kLengthOffset));
+    __ cmp(r0, r3);
+    __ b(gt, &slow_copy);
+    // r4: address of the next element, r5: end of the elements to copy.
+    __ add(r4, r2, Operand(FixedArray::kHeaderSize - kHeapObjectTag));
+    __ add(r5, r4, Operand::PointerOffsetFromSmiKey(r0));
+    __ LoadRoot(r6, Heap::kTheHoleValueRootIndex);
+    __ b(&copy_entry);
+    __ bind(&copy_loop);
+    __ ldr(r3, MemOperand(r4, kPointerSize, PostIndex));
+    __ cmp(r3, r6);
+    __ b(eq, &copy_hole);
+    __ push(r3);
+    __ bind(&copy_entry);
+    __ cmp(r4, r5);
+    __ b(ne, &copy_loop);
+    __ b(&invoke);
+
+    // Drop the elements copied so far and start over with the runtime.
+    __ bind(&copy_hole);
+    __ add(r3, r2, Operand(FixedArray::kHeaderSize - kHeapObjectTag +
+                           kPointerSize));
+    __ sub(r4, r4, r3);
+    __ add(sp, sp, r4);
+
+    __ bind(&slow_copy);
     __ ldr(r0, MemOperand(fp, kIndexOffset));
     __ b(&entry);
 
@@ -1379,6 +1423,7 @@ void Builtins::Generate_FunctionApply(MacroAssembler* masm) {
     __ b(ne, &loop);
 
     // Call the function.
+    __ bind(&invoke);
     Label call_proxy;
     ParameterCount actual(r0);
     __ SmiUntag(r0);
@@ -1339,15 +1339,56 @@ void Builtins::Generate_FunctionApply(MacroAssembler* masm) {
     __ Bind(&push_receiver);
     __ Push(receiver);
 
-    // Copy all arguments from the array to the stack.
-    Label entry, loop;
+    // Copy all arguments from the array to the stack. Arrays and arguments
+    // objects with fast elements are copied straight from their backing store
+    // unless they contain holes, which need a lookup on the prototype chain.
+    Label entry, loop, slow_copy, check_elements_kind, copy_loop, copy_entry;
+    Label copy_hole, invoke;
     Register current = x0;
+    __ Ldr(x1, MemOperand(fp, kArgsOffset));
+    __ JumpIfSmi(x1, &slow_copy);
+    __ Ldr(x10, FieldMemOperand(x1, HeapObject::kMapOffset));
+    __ Ldrb(w11, FieldMemOperand(x10, Map::kBitFieldOffset));
+    __ TestAndBranchIfAnySet(x11,
+                             (1 << Map::kHasIndexedInterceptor) |
+                             (1 << Map::kIsAccessCheckNeeded),
+                             &slow_copy);
+    __ CompareInstanceType(x10, x11, JS_ARRAY_TYPE);
+    __ B(eq, &check_elements_kind);
+    __ Cmp(x11, JS_OBJECT_TYPE);
+    __ B(ne, &slow_copy);
+    __ Bind(&check_elements_kind);
+    __ CheckFastElements(x10, x11, &slow_copy);
+    __ Ldr(x10, FieldMemOperand(x1, JSObject::kElementsOffset));
+    __ Ldr(current, MemOperand(fp, kLimitOffset));
+    __ Ldr(x11, FieldMemOperand(x10, FixedArray::kLengthOffset));
+    __ Cmp(current, x11);
+    __ B(gt, &slow_copy);
+    // x10: start of the elements, x12: elements copied, x13: elements to copy.
+    __ Add(x10, x10, FixedArray::kHeaderSize - kHeapObjectTag);
+    __ Mov(x12, 0);
+    __ SmiUntag(x13, current);
+    __ B(&copy_entry);
+    __ Bind(&copy_loop);
+    __ Ldr(x11, MemOperand(x10, x12, LSL, kPointerSizeLog2));
+    __ JumpIfRoot(x11, Heap::kTheHoleValueRootIndex, &copy_hole);
+    __ Push(x11);
+    __ Add(x12, x12, 1);
+    __ Bind(&copy_entry);
+    __ Cmp(x12, x13);
+    __ B(ne, &copy_loop);
+    __ B(&invoke);
+
+    // Drop the elements copied so far and start over with the runtime.
+    __ Bind(&copy_hole);
+    __ Drop(x12);
+
+    __ Bind(&slow_copy);
     __ Ldr(current, MemOperand(fp, kIndexOffset));
     __ B(&entry);
 
     __ Bind(&loop);
     // Load the current argument from the arguments array and push it.
-    // TODO(all): Couldn't we optimize this for JS arrays?
 
     __ Ldr(x1, MemOperand(fp, kArgsOffset));
     __ Push(x1, current);
@@ -1367,6 +1408,7 @@ void Builtins::Generate_FunctionApply(MacroAssembler* masm) {
     __ Ldr(x1, MemOperand(fp, kLimitOffset));
     __ Cmp(current, x1);
     __ B(ne, &loop);
+    __ Bind(&invoke);
 
     // At the end of the loop, the number of arguments is stored in 'current',
     // represented as a smi.
@@ -0,0 +1,304 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "array-buffer-allocator.h"
+
+#include "v8.h"
+
+namespace v8 {
+namespace internal {
+
+AtomicWord PoolingArrayBufferAllocator::instances_ = 0;
+LazyMutex PoolingArrayBufferAllocator::instances_mutex_ =
+    LAZY_MUTEX_INITIALIZER;
+
+
+PoolingArrayBufferAllocator::PoolingArrayBufferAllocator()
+    : cache_key_(Thread::CreateThreadLocalKey(&ThreadCacheExited)),
+      thread_caches_(NULL) {
+  for (int i = 0; i < kSizeClassCount; i++) {
+    pool_[i] = NULL;
+    pool_depth_[i] = 0;
+  }
+  LockGuard<Mutex> lock_guard(instances_mutex_.Pointer());
+  next_instance_ = reinterpret_cast<PoolingArrayBufferAllocator*>(
+      Acquire_Load(&instances_));
+  Release_Store(&instances_, reinterpret_cast<AtomicWord>(this));
+}
+
+
+PoolingArrayBufferAllocator::~PoolingArrayBufferAllocator() {
+  {
+    // No isolate may still be using the allocator, so nobody can be walking
+    // past this instance in IsInstance.
+    LockGuard<Mutex> lock_guard(instances_mutex_.Pointer());
+    PoolingArrayBufferAllocator* head =
+        reinterpret_cast<PoolingArrayBufferAllocator*>(
+            Acquire_Load(&instances_));
+    if (head == this) {
+      Release_Store(&instances_,
+                    reinterpret_cast<AtomicWord>(next_instance_));
+    } else {
+      while (head->next_instance_ != this) head = head->next_instance_;
+      head->next_instance_ = next_instance_;
+    }
+  }
+  // Deleting the key first keeps exiting threads from running the cache
+  // destructor. The allocator outlives all threads that use it, so the
+  // remaining thread caches can be drained without synchronization.
+  Thread::DeleteThreadLocalKey(cache_key_);
+  while (thread_caches_ != NULL) {
+    ThreadCache* cache = thread_caches_;
+    thread_caches_ = cache->next;
+    for (int i = 0; i < kSizeClassCount; i++) {
+      while (cache->blocks[i] != NULL) {
+        FreeBlock* block = cache->blocks[i];
+        cache->blocks[i] = block->next;
+        free(block);
+      }
+    }
+    delete cache;
+  }
+  for (int i = 0; i < kSizeClassCount; i++) {
+    while (pool_[i] != NULL) {
+      FreeBlock* block = pool_[i];
+      pool_[i] = block->next;
+      free(block);
+    }
+  }
+}
+
+
+size_t PoolingArrayBufferAllocator::ChargedSize(size_t length) {
+  if (length == 0) return 0;
+  if (length > kMaxPooledSize) return RoundUp(length, OS::AllocateAlignment());
+  return SizeOfClass(SizeClassFor(length));
+}
+
+
+bool PoolingArrayBufferAllocator::IsInstance(
+    v8::ArrayBuffer::Allocator* allocator) {
+  PoolingArrayBufferAllocator* instance =
+      reinterpret_cast<PoolingArrayBufferAllocator*>(
+          Acquire_Load(&instances_));
+  for (; instance != NULL; instance = instance->next_instance_) {
+    if (instance == allocator) return true;
+  }
+  return false;
+}
+
+
+int PoolingArrayBufferAllocator::SizeClassFor(size_t length) {
+  ASSERT(length <= kMaxPooledSize);
+  int size_class = 0;
+  while (SizeOfClass(size_class) < length) size_class++;
+  return size_class;
+}
+
+
+int PoolingArrayBufferAllocator::MaxThreadCacheDepth(int size_class) {
+  size_t depth = kThreadCacheBytesPerClass / SizeOfClass(size_class);
+  if (depth < 1) return 1;
+  if (depth > kMaxThreadCacheDepth) return kMaxThreadCacheDepth;
+  return static_cast<int>(depth);
+}
+
+
+PoolingArrayBufferAllocator::ThreadCache*
+    PoolingArrayBufferAllocator::GetThreadCache() {
+  ThreadCache* cache =
+      reinterpret_cast<ThreadCache*>(Thread::GetThreadLocal(cache_key_));
+  if (cache != NULL) return cache;
+  cache = new ThreadCache;
+  cache->allocator = this;
+  for (int i = 0; i < kSizeClassCount; i++) {
+    cache->blocks[i] = NULL;
+    cache->depth[i] = 0;
+  }
+  {
+    LockGuard<Mutex> lock_guard(&mutex_);
+    cache->next = thread_caches_;
+    thread_caches_ = cache;
+  }
+  Thread::SetThreadLocal(cache_key_, cache);
+  return cache;
+}
+
+
+void PoolingArrayBufferAllocator::ThreadCacheExited(void* cache) {
+  ThreadCache* thread_cache = reinterpret_cast<ThreadCache*>(cache);
+  thread_cache->allocator->ReleaseThreadCache(thread_cache);
+}
+
+
+void PoolingArrayBufferAllocator::ReleaseThreadCache(ThreadCache* cache) {
+  FreeBlock* overflow = NULL;
+  {
+    LockGuard<Mutex> lock_guard(&mutex_);
+    ThreadCache** link = &thread_caches_;
+    while (*link != cache) link = &(*link)->next;
+    *link = cache->next;
+    for (int i = 0; i < kSizeClassCount; i++) {
+      while (cache->blocks[i] != NULL) {
+        FreeBlock* block = cache->blocks[i];
+        cache->blocks[i] = block->next;
+        if (!AddToPool(block, i)) {
+          block->next = overflow;
+          overflow = block;
+        }
+      }
+    }
+  }
+  while (overflow != NULL) {
+    FreeBlock* block = overflow;
+    overflow = block->next;
+    free(block);
+  }
+  delete cache;
+}
+
+
+bool PoolingArrayBufferAllocator::AddToPool(FreeBlock* block,
+                                            int size_class) {
+  if (pool_depth_[size_class] >= MaxPoolDepth(size_class)) return false;
+  block->next = pool_[size_class];
+  pool_[size_class] = block;
+  pool_depth_[size_class]++;
+  return true;
+}
+
+
+void* PoolingArrayBufferAllocator::TakeCachedBlock(int size_class) {
+  ThreadCache* cache = GetThreadCache();
+  if (cache->blocks[size_class] == NULL) {
+    // Refill half of the thread cache from the shared pool.
+    LockGuard<Mutex> lock_guard(&mutex_);
+    int refill = (MaxThreadCacheDepth(size_class) + 1) / 2;
+    while (refill-- > 0 && pool_[size_class] != NULL) {
+      FreeBlock* block = pool_[size_class];
+      pool_[size_class] = block->next;
+      pool_depth_[size_class]--;
+      block->next = cache->blocks[size_class];
+      cache->blocks[size_class] = block;
+      cache->depth[size_class]++;
+    }
+  }
+  FreeBlock* block = cache->blocks[size_class];
+  if (block == NULL) return NULL;
+  cache->blocks[size_class] = block->next;
+  cache->depth[size_class]--;
+  return block;
+}
+
+
+void PoolingArrayBufferAllocator::FreeBlockToCache(void* data,
+                                                   int size_class) {
+  ThreadCache* cache = GetThreadCache();
+  FreeBlock* block = reinterpret_cast<FreeBlock*>(data);
+  block->next = cache->blocks[size_class];
+  cache->blocks[size_class] = block;
+  int max_depth = MaxThreadCacheDepth(size_class);
+  if (++cache->depth[size_class] <= max_depth) return;
+
+  // Flush half of the thread cache to the shared pool, and release what does
+  // not fit there.
+  int flush = max_depth / 2 + 1;
+  FreeBlock* overflow = NULL;
+  {
+    LockGuard<Mutex> lock_guard(&mutex_);
+    while (flush-- > 0) {
+      block = cache->blocks[size_class];
+      cache->blocks[size_class] = block->next;
+      cache->depth[size_class]--;
+      if (!AddToPool(block, size_class)) {
+        block->next = overflow;
+        overflow = block;
+      }
+    }
+  }
+  while (overflow != NULL) {
+    block = overflow;
+    overflow = block->next;
+    free(block);
+  }
+}
+
+
+void* PoolingArrayBufferAllocator::AllocateMapped(size_t length) {
+  size_t size = RoundUp(length, OS::AllocateAlignment());
+  void* base = VirtualMemory::ReserveRegion(size);
+  if (base == NULL) return NULL;
+  if (!VirtualMemory::CommitRegion(base, size, false)) {
+    VirtualMemory::ReleaseRegion(base, size);
+    return NULL;
+  }
+  return base;
+}
+
+
+void PoolingArrayBufferAllocator::FreeMapped(void* data, size_t length) {
+  size_t size = RoundUp(length, OS::AllocateAlignment());
+  bool result = VirtualMemory::ReleaseRegion(data, size);
+  USE(result);
+  ASSERT(result);
+}
+
+
+void* PoolingArrayBufferAllocator::Allocate(size_t length) {
+  // Freshly mapped pages are zero-filled by the OS.
+  if (length > kMaxPooledSize) return AllocateMapped(length);
+  int size_class = SizeClassFor(length);
+  void* data = TakeCachedBlock(size_class);
+  if (data == NULL) {
+    // Leave it to calloc to decide whether fresh memory needs clearing.
+    return calloc(1, SizeOfClass(size_class));
+  }
+  // Only the requested part of a recycled block has to be cleared.
+  memset(data, 0, length);
+  return data;
+}
+
+
+void* PoolingArrayBufferAllocator::AllocateUninitialized(size_t length) {
+  if (length > kMaxPooledSize) return AllocateMapped(length);
+  int size_class = SizeClassFor(length);
+  void* data = TakeCachedBlock(size_class);
+  if (data == NULL) return malloc(SizeOfClass(size_class));
+  return data;
+}
+
+
+void PoolingArrayBufferAllocator::Free(void* data, size_t length) {
+  if (data == NULL) return;
+  if (length > kMaxPooledSize) {
+    FreeMapped(data, length);
+  } else {
+    FreeBlockToCache(data, SizeClassFor(length));
+  }
+}
+
+} }  // namespace v8::internal
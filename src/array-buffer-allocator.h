@@ -0,0 +1,141 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef V8_ARRAY_BUFFER_ALLOCATOR_H_
+#define V8_ARRAY_BUFFER_ALLOCATOR_H_
+
+#include "../include/v8.h"
+#include "atomicops.h"
+#include "globals.h"
+#include "platform.h"
+#include "platform/mutex.h"
+
+namespace v8 {
+namespace internal {
+
+// Default ArrayBuffer::Allocator.  Backing stores up to kMaxPooledSize bytes
+// are rounded up to a power of two and recycled through a small per-thread
+// cache that is refilled from and flushed to a shared pool.  Larger backing
+// stores are mapped directly from the OS, whose fresh pages are already
+// zeroed, and unmapped when they are freed.
+//
+// A thread's cache is returned to the shared pool when the thread exits.
+// Windows has no thread exit hook for this, so there the caches of exited
+// threads are only released with the allocator.
+//
+// Isolates are charged for each backing store at its ChargedSize,
+// which includes the rounding up to a size class or to whole pages. Blocks
+// parked in thread caches and in the pool are shared by all isolates and
+// are not charged to any of them: up to kPoolBytesPerClass per size class
+// in the pool, and up to kThreadCacheBytesPerClass per size class in each
+// thread cache.
+class PoolingArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
+ public:
+  PoolingArrayBufferAllocator();
+  virtual ~PoolingArrayBufferAllocator();
+
+  virtual void* Allocate(size_t length) V8_OVERRIDE;
+  virtual void* AllocateUninitialized(size_t length) V8_OVERRIDE;
+  virtual void Free(void* data, size_t length) V8_OVERRIDE;
+
+  static const int kMinPooledSizeLog2 = 4;
+  static const int kMaxPooledSizeLog2 = 18;
+  static const size_t kMaxPooledSize = 1 << kMaxPooledSizeLog2;
+  static const int kSizeClassCount =
+      kMaxPooledSizeLog2 - kMinPooledSizeLog2 + 1;
+
+  // Upper bounds on the bytes parked per size class in a thread cache and
+  // in the shared pool.
+  static const size_t kThreadCacheBytesPerClass = 256 * KB;
+  static const size_t kPoolBytesPerClass = 4 * MB;
+  static const int kMaxThreadCacheDepth = 32;
+
+  // Returns the number of bytes a backing store of |length| bytes actually
+  // occupies.
+  static size_t ChargedSize(size_t length);
+
+  // Returns whether |allocator| is a live PoolingArrayBufferAllocator.
+  static bool IsInstance(v8::ArrayBuffer::Allocator* allocator);
+
+ private:
+  // Freed blocks are chained through their first word.
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  struct ThreadCache {
+    PoolingArrayBufferAllocator* allocator;
+    ThreadCache* next;
+    FreeBlock* blocks[kSizeClassCount];
+    int depth[kSizeClassCount];
+  };
+
+  static int SizeClassFor(size_t length);
+  static size_t SizeOfClass(int size_class) {
+    return static_cast<size_t>(1) << (size_class + kMinPooledSizeLog2);
+  }
+  static int MaxThreadCacheDepth(int size_class);
+  static int MaxPoolDepth(int size_class) {
+    return static_cast<int>(kPoolBytesPerClass / SizeOfClass(size_class));
+  }
+
+  ThreadCache* GetThreadCache();
+  // Thread-local storage destructor for a thread's cache.
+  static void ThreadCacheExited(void* cache);
+  // Moves the blocks of an exited thread's cache to the shared pool and
+  // frees the cache.
+  void ReleaseThreadCache(ThreadCache* cache);
+  // Pushes |block| onto the shared pool unless that size class is full.
+  // Must be called with mutex_ held.
+  bool AddToPool(FreeBlock* block, int size_class);
+  // Returns NULL if neither the thread cache nor the pool has a block.
+  void* TakeCachedBlock(int size_class);
+  void FreeBlockToCache(void* data, int size_class);
+  void* AllocateMapped(size_t length);
+  void FreeMapped(void* data, size_t length);
+
+  Thread::LocalStorageKey cache_key_;
+
+  // Protects the shared pool and the list of thread caches.
+  Mutex mutex_;
+  FreeBlock* pool_[kSizeClassCount];
+  int pool_depth_[kSizeClassCount];
+  ThreadCache* thread_caches_;
+
+  // Live allocators, chained through next_instance_. New allocators are
+  // published with a release store so that IsInstance can walk the list
+  // without taking instances_mutex_.
+  static AtomicWord instances_;
+  static LazyMutex instances_mutex_;
+  PoolingArrayBufferAllocator* next_instance_;
+
+  DISALLOW_COPY_AND_ASSIGN(PoolingArrayBufferAllocator);
+};
+
+} }  // namespace v8::internal
+
+#endif  // V8_ARRAY_BUFFER_ALLOCATOR_H_
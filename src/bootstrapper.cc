@@ -9,6 +9,7 @@
 #include "natives.h"
 #include "snapshot.h"
 #include "trig-table.h"
+#include "extensions/batch-math-extension.h"
 #include "extensions/externalize-string-extension.h"
 #include "extensions/free-buffer-extension.h"
 #include "extensions/gc-extension.h"
@@ -76,6 +77,7 @@ static const char* GCFunctionName() {
 }
 
 
+v8::Extension* Bootstrapper::batch_math_extension_ = NULL;
 v8::Extension* Bootstrapper::free_buffer_extension_ = NULL;
 v8::Extension* Bootstrapper::gc_extension_ = NULL;
 v8::Extension* Bootstrapper::externalize_string_extension_ = NULL;
@@ -84,6 +86,8 @@ v8::Extension* Bootstrapper::trigger_failure_extension_ = NULL;
 
 
 void Bootstrapper::InitializeOncePerProcess() {
+  batch_math_extension_ = new BatchMathExtension;
+  v8::RegisterExtension(batch_math_extension_);
   free_buffer_extension_ = new FreeBufferExtension;
   v8::RegisterExtension(free_buffer_extension_);
   gc_extension_ = new GCExtension(GCFunctionName());
@@ -98,6 +102,7 @@ void Bootstrapper::InitializeOncePerProcess() {
 
 
 void Bootstrapper::TearDownExtensions() {
+  delete batch_math_extension_;
   delete free_buffer_extension_;
   delete gc_extension_;
   delete externalize_string_extension_;
@@ -210,6 +215,18 @@ class Genesis BASE_EMBEDDED {
   Handle<JSFunction> InstallTypedArray(const char* name,
       ElementsKind elementsKind);
   bool InstallExperimentalNatives();
+  // Defers compiling experimental native |index| until one of the named
+  // globals (a NULL terminated list) is first read or written.
+  void InstallLazyExperimentalNative(int index, const char* const* names);
+  static void LazyExperimentalNativeGetter(
+      v8::Local<v8::String> property,
+      const v8::PropertyCallbackInfo<v8::Value>& info);
+  static void LazyExperimentalNativeSetter(
+      v8::Local<v8::String> property,
+      v8::Local<v8::Value> value,
+      const v8::PropertyCallbackInfo<void>& info);
+  static bool CompileLazyExperimentalNative(Handle<JSObject> global,
+                                            Handle<FixedArray> data);
   void InstallBuiltinFunctionIds();
   void InstallJSFunctionResultCaches();
   void InitializeNormalizedMapCaches();
@@ -1552,10 +1569,6 @@ void Genesis::InstallNativeFunctions() {
 
 
 void Genesis::InstallExperimentalNativeFunctions() {
-  INSTALL_NATIVE(JSFunction, "RunMicrotasks", run_microtasks);
-  INSTALL_NATIVE(JSFunction, "EnqueueExternalMicrotask",
-                 enqueue_external_microtask);
-
   if (FLAG_harmony_promises) {
     INSTALL_NATIVE(JSFunction, "IsPromise", is_promise);
     INSTALL_NATIVE(JSFunction, "PromiseCreate", promise_create);
@@ -2005,14 +2018,40 @@ bool Genesis::InstallNatives() {
   }
 
 
+// Natives that do nothing but fill in the functions created for a few
+// globals in InitializeExperimentalGlobal can wait until a script touches
+// one of those globals.  The snapshot cannot hold the accessors, and
+// promise.js refers to $WeakMap while it is being compiled.
+#define INSTALL_LAZY_EXPERIMENTAL_NATIVE(i, flag, file, names, lazy)   \
+  if (FLAG_harmony_##flag &&                                          \
+      strcmp(ExperimentalNatives::GetScriptName(i).start(),           \
+          "native " file) == 0) {                                     \
+    if (FLAG_lazy_experimental_natives && !Serializer::enabled() &&   \
+        (lazy)) {                                                     \
+      InstallLazyExperimentalNative(i, names);                        \
+    } else if (!CompileExperimentalBuiltin(isolate(), i)) {           \
+      return false;                                                   \
+    }                                                                 \
+  }
+
+
+static const char* const kCollectionGlobals[] = { "Map", "Set", NULL };
+static const char* const kWeakCollectionGlobals[] = {
+  "WeakMap", "WeakSet", NULL
+};
+
+
 bool Genesis::InstallExperimentalNatives() {
   for (int i = ExperimentalNatives::GetDebuggerCount();
        i < ExperimentalNatives::GetBuiltinsCount();
        i++) {
     INSTALL_EXPERIMENTAL_NATIVE(i, symbols, "symbol.js")
     INSTALL_EXPERIMENTAL_NATIVE(i, proxies, "proxy.js")
-    INSTALL_EXPERIMENTAL_NATIVE(i, collections, "collection.js")
-    INSTALL_EXPERIMENTAL_NATIVE(i, weak_collections, "weak_collection.js")
+    INSTALL_LAZY_EXPERIMENTAL_NATIVE(i, collections, "collection.js",
+                                     kCollectionGlobals, true)
+    INSTALL_LAZY_EXPERIMENTAL_NATIVE(i, weak_collections, "weak_collection.js",
+                                     kWeakCollectionGlobals,
+                                     !FLAG_harmony_promises)
     INSTALL_EXPERIMENTAL_NATIVE(i, promises, "promise.js")
     INSTALL_EXPERIMENTAL_NATIVE(i, generators, "generator.js")
     INSTALL_EXPERIMENTAL_NATIVE(i, iteration, "array-iterator.js")
@@ -2027,6 +2066,101 @@ bool Genesis::InstallExperimentalNatives() {
 }
 
 
+void Genesis::InstallLazyExperimentalNative(int index,
+                                            const char* const* names) {
+  Handle<JSObject> global(native_context()->global_object());
+  int count = 0;
+  while (names[count] != NULL) count++;
+
+  // The accessor data holds the native's index followed by the name and
+  // original value of every global that has to be restored.
+  Handle<FixedArray> data = factory()->NewFixedArray(1 + 2 * count);
+  data->set(0, Smi::FromInt(index));
+  for (int i = 0; i < count; i++) {
+    Handle<String> name = factory()->InternalizeUtf8String(names[i]);
+    Handle<Object> value = Object::GetProperty(global, name);
+    ASSERT(value->IsJSFunction());
+    data->set(1 + 2 * i, *name);
+    data->set(2 + 2 * i, *value);
+  }
+
+  for (int i = 0; i < count; i++) {
+    Handle<ExecutableAccessorInfo> info =
+        factory()->NewExecutableAccessorInfo();
+    info->set_property_attributes(DONT_ENUM);
+    info->set_name(data->get(1 + 2 * i));
+    info->set_data(*data);
+    info->set_getter(*v8::FromCData(isolate(), &LazyExperimentalNativeGetter));
+    info->set_setter(*v8::FromCData(isolate(), &LazyExperimentalNativeSetter));
+    JSObject::SetAccessor(global, info);
+  }
+}
+
+
+bool Genesis::CompileLazyExperimentalNative(Handle<JSObject> global,
+                                            Handle<FixedArray> data) {
+  Isolate* isolate = global->GetIsolate();
+  // Compiling the native needs stack. Without it, throw and leave the
+  // accessors in place so that a later access can try again.
+  StackLimitCheck check(isolate);
+  if (check.HasOverflowed()) {
+    isolate->StackOverflow();
+    Object* exception = isolate->pending_exception();
+    isolate->clear_pending_exception();
+    isolate->ScheduleThrow(exception);
+    return false;
+  }
+
+  // Put the original functions back first; the native reads them off the
+  // global object while it runs.
+  for (int i = 1; i < data->length(); i += 2) {
+    Handle<String> name(String::cast(data->get(i)));
+    Handle<Object> value(data->get(i + 1), isolate);
+    JSObject::SetLocalPropertyIgnoreAttributes(
+        global, name, value, DONT_ENUM).Check();
+  }
+
+  SaveContext save(isolate);
+  isolate->set_context(GlobalObject::cast(*global)->native_context());
+  BootstrapperActive active(isolate->bootstrapper());
+  int index = Smi::cast(data->get(0))->value();
+  if (!CompileExperimentalBuiltin(isolate, index)) {
+    // The globals now hold functions whose prototypes were never filled in,
+    // and there is no way back to a usable context.
+    FATAL("Failed to compile an experimental native on first use");
+  }
+  return true;
+}
+
+
+void Genesis::LazyExperimentalNativeGetter(
+    v8::Local<v8::String> property,
+    const v8::PropertyCallbackInfo<v8::Value>& info) {
+  Handle<JSObject> global = v8::Utils::OpenHandle(*info.Holder());
+  Handle<FixedArray> data =
+      Handle<FixedArray>::cast(v8::Utils::OpenHandle(*info.Data()));
+  if (!CompileLazyExperimentalNative(global, data)) return;
+  Handle<Object> value =
+      Object::GetProperty(global, v8::Utils::OpenHandle(*property));
+  if (value.is_null()) return;
+  info.GetReturnValue().Set(v8::Utils::ToLocal(value));
+}
+
+
+void Genesis::LazyExperimentalNativeSetter(
+    v8::Local<v8::String> property,
+    v8::Local<v8::Value> value,
+    const v8::PropertyCallbackInfo<void>& info) {
+  Handle<JSObject> global = v8::Utils::OpenHandle(*info.Holder());
+  Handle<FixedArray> data =
+      Handle<FixedArray>::cast(v8::Utils::OpenHandle(*info.Data()));
+  if (!CompileLazyExperimentalNative(global, data)) return;
+  JSObject::SetLocalPropertyIgnoreAttributes(
+      global, v8::Utils::OpenHandle(*property), v8::Utils::OpenHandle(*value),
+      DONT_ENUM).Check();
+}
+
+
 static Handle<JSObject> ResolveBuiltinIdHolder(
     Handle<Context> native_context,
     const char* holder_expr) {
@@ -2236,6 +2370,8 @@ bool Genesis::InstallExtensions(Handle<Context> native_context,
   Isolate* isolate = native_context->GetIsolate();
   ExtensionStates extension_states;  // All extensions have state UNVISITED.
   return InstallAutoExtensions(isolate, &extension_states) &&
+      (!FLAG_expose_batch_math ||
+       InstallExtension(isolate, "v8/batch-math", &extension_states)) &&
       (!FLAG_expose_free_buffer ||
        InstallExtension(isolate, "v8/free-buffer", &extension_states)) &&
       (!FLAG_expose_gc ||
@@ -2631,14 +2767,15 @@ Genesis::Genesis(Isolate* isolate,
   // creation time and we don't need trigonometric functions then.
   if (!Serializer::enabled()) {
     // Initially seed the per-context random number generator using the
-    // per-isolate random number generator.
-    const int num_elems = 2;
+    // per-isolate random number generator. The xorshift128+ state must not
+    // be all zero.
+    const int num_elems = 4;
     const int num_bytes = num_elems * sizeof(uint32_t);
     uint32_t* state = reinterpret_cast<uint32_t*>(malloc(num_bytes));
 
     do {
       isolate->random_number_generator()->NextBytes(state, num_bytes);
-    } while (state[0] == 0 || state[1] == 0);
+    } while ((state[0] | state[1] | state[2] | state[3]) == 0);
 
     v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(
         reinterpret_cast<v8::Isolate*>(isolate), state, num_bytes);
@@ -2651,6 +2788,21 @@ Genesis::Genesis(Isolate* isolate,
                                     Utils::OpenHandle(*ta),
                                     NONE).Assert();
 
+    // Math.random reads its values from a cache that is refilled in batches.
+    const int cache_num_elems = 64;
+    const int cache_num_bytes = cache_num_elems * sizeof(double);
+    void* cache = malloc(cache_num_bytes);
+    v8::Local<v8::ArrayBuffer> cache_buffer = v8::ArrayBuffer::New(
+        reinterpret_cast<v8::Isolate*>(isolate), cache, cache_num_bytes);
+    Utils::OpenHandle(*cache_buffer)->set_should_be_freed(true);
+    v8::Local<v8::Float64Array> cache_ta =
+        v8::Float64Array::New(cache_buffer, 0, cache_num_elems);
+    Runtime::ForceSetObjectProperty(builtins,
+                                    factory()->InternalizeOneByteString(
+                                        STATIC_ASCII_VECTOR("rngcache")),
+                                    Utils::OpenHandle(*cache_ta),
+                                    NONE).Assert();
+
     // Initialize trigonometric lookup tables and constants.
     const int table_num_bytes = TrigonometricLookupTable::table_num_bytes();
     v8::Local<v8::ArrayBuffer> sin_buffer = v8::ArrayBuffer::New(
@@ -123,6 +123,7 @@ class Bootstrapper V8_FINAL {
 
   explicit Bootstrapper(Isolate* isolate);
 
+  static v8::Extension* batch_math_extension_;
   static v8::Extension* free_buffer_extension_;
   static v8::Extension* gc_extension_;
   static v8::Extension* externalize_string_extension_;
@@ -277,6 +277,7 @@ CPU::CPU() : stepping_(0),
              has_ssse3_(false),
              has_sse41_(false),
              has_sse42_(false),
+             has_non_stop_time_stamp_counter_(false),
              has_idiva_(false),
              has_neon_(false),
              has_thumbee_(false),
@@ -336,6 +337,13 @@ CPU::CPU() : stepping_(0),
 #endif
   }
 
+  // An invariant time stamp counter ticks at a constant rate in all ACPI P-,
+  // C- and T-states.
+  if (num_ext_ids >= 0x80000007) {
+    __cpuid(cpu_info, 0x80000007);
+    has_non_stop_time_stamp_counter_ = (cpu_info[3] & (1 << 8)) != 0;
+  }
+
 #elif V8_HOST_ARCH_ARM
 
 #if V8_OS_LINUX
@@ -90,6 +90,9 @@ class CPU V8_FINAL BASE_EMBEDDED {
   bool has_ssse3() const { return has_ssse3_; }
   bool has_sse41() const { return has_sse41_; }
   bool has_sse42() const { return has_sse42_; }
+  bool has_non_stop_time_stamp_counter() const {
+    return has_non_stop_time_stamp_counter_;
+  }
 
   // arm features
   bool has_idiva() const { return has_idiva_; }
@@ -131,6 +134,7 @@ class CPU V8_FINAL BASE_EMBEDDED {
   bool has_ssse3_;
   bool has_sse41_;
   bool has_sse42_;
+  bool has_non_stop_time_stamp_counter_;
   bool has_idiva_;
   bool has_neon_;
   bool has_thumbee_;
@@ -66,6 +66,7 @@
 #include "debug.h"
 #include "natives.h"
 #include "platform.h"
+#include "runtime.h"
 #include "v8.h"
 #endif  // V8_SHARED
 
@@ -161,6 +162,8 @@ i::OS::MemoryMappedFile* Shell::counters_file_ = NULL;
 CounterCollection Shell::local_counters_;
 CounterCollection* Shell::counters_ = &local_counters_;
 i::Mutex Shell::context_mutex_;
+i::Mutex Shell::workers_mutex_;
+i::List<Worker*> Shell::workers_;
 const i::TimeTicks Shell::kInitialTicks = i::TimeTicks::HighResolutionNow();
 Persistent<Context> Shell::utility_context_;
 #endif  // V8_SHARED
@@ -773,6 +776,12 @@ void Shell::AddHistogramSample(void* histogram, int sample) {
 }
 
 
+int32_t Shell::HistogramTotal(const char* name) {
+  Counter* counter = counter_map_->Lookup(name);
+  return counter == NULL ? 0 : counter->sample_total();
+}
+
+
 void Shell::InstallUtilityScript(Isolate* isolate) {
   Locker lock(isolate);
   HandleScope scope(isolate);
@@ -907,6 +916,21 @@ Handle<ObjectTemplate> Shell::CreateGlobalTemplate(Isolate* isolate) {
                             FunctionTemplate::New(isolate, PerformanceNow));
   global_template->Set(String::NewFromUtf8(isolate, "performance"),
                        performance_template);
+
+  Handle<FunctionTemplate> worker_fun_template =
+      FunctionTemplate::New(isolate, WorkerNew);
+  worker_fun_template->PrototypeTemplate()->Set(
+      String::NewFromUtf8(isolate, "terminate"),
+      FunctionTemplate::New(isolate, WorkerTerminate));
+  worker_fun_template->PrototypeTemplate()->Set(
+      String::NewFromUtf8(isolate, "postMessage"),
+      FunctionTemplate::New(isolate, WorkerPostMessage));
+  worker_fun_template->PrototypeTemplate()->Set(
+      String::NewFromUtf8(isolate, "getMessage"),
+      FunctionTemplate::New(isolate, WorkerGetMessage));
+  worker_fun_template->InstanceTemplate()->SetInternalFieldCount(1);
+  global_template->Set(String::NewFromUtf8(isolate, "Worker"),
+                       worker_fun_template);
 #endif  // V8_SHARED
 
 #if !defined(V8_SHARED) && !defined(_WIN32) && !defined(_WIN64)
@@ -934,7 +958,8 @@ void Shell::Initialize(Isolate* isolate) {
   // Set up counters
   if (i::StrLength(i::FLAG_map_counters) != 0)
     MapCounters(i::FLAG_map_counters);
-  if (i::FLAG_dump_counters || i::FLAG_track_gc_object_stats) {
+  if (i::FLAG_dump_counters || i::FLAG_track_gc_object_stats ||
+      options.bench) {
     V8::SetCounterFunction(LookupCounter);
     V8::SetCreateHistogramFunction(CreateHistogram);
     V8::SetAddHistogramSampleFunction(AddHistogramSample);
@@ -1382,6 +1407,693 @@ void SourceGroup::WaitForThread() {
     done_semaphore_.Wait();
   }
 }
+
+
+SerializationData::~SerializationData() {
+  // Free backing stores that never made it into a receiving isolate.
+  for (int i = 0; i < array_buffer_contents_.length(); ++i) {
+    ArrayBufferContents& contents = array_buffer_contents_[i];
+    if (contents.data == NULL) continue;
+    i::V8::ArrayBufferAllocator()->Free(contents.data, contents.byte_length);
+  }
+}
+
+
+void SerializationData::WriteMemory(const void* p, int length) {
+  if (length > 0) {
+    i::Vector<uint8_t> block = data_.AddBlock(0, length);
+    i::OS::MemCopy(&block[0], p, length);
+  }
+}
+
+
+int SerializationData::AddArrayBufferContents(void* data, size_t byte_length) {
+  ArrayBufferContents contents = { data, byte_length };
+  array_buffer_contents_.Add(contents);
+  return array_buffer_contents_.length() - 1;
+}
+
+
+void SerializationData::SetArrayBufferContents(int index,
+                                               void* data,
+                                               size_t byte_length) {
+  ASSERT(array_buffer_contents_[index].data == NULL);
+  array_buffer_contents_[index].data = data;
+  array_buffer_contents_[index].byte_length = byte_length;
+}
+
+
+SerializationTag SerializationData::ReadTag(int* offset) const {
+  return static_cast<SerializationTag>(Read<uint8_t>(offset));
+}
+
+
+void SerializationData::ReadMemory(void* p, int length, int* offset) const {
+  if (length > 0) {
+    i::OS::MemCopy(p, &data_[*offset], length);
+    (*offset) += length;
+  }
+}
+
+
+void SerializationData::ReadArrayBufferContents(int index,
+                                                void** data,
+                                                size_t* byte_length) {
+  ArrayBufferContents& contents = array_buffer_contents_[index];
+  *data = contents.data;
+  *byte_length = contents.byte_length;
+  contents.data = NULL;
+  contents.byte_length = 0;
+}
+
+
+void SerializationDataQueue::Enqueue(SerializationData* data) {
+  i::LockGuard<i::Mutex> lock_guard(&mutex_);
+  data_.Add(data);
+}
+
+
+bool SerializationDataQueue::Dequeue(SerializationData** data) {
+  i::LockGuard<i::Mutex> lock_guard(&mutex_);
+  if (data_.is_empty()) return false;
+  *data = data_.Remove(0);
+  return true;
+}
+
+
+void SerializationDataQueue::Clear() {
+  i::LockGuard<i::Mutex> lock_guard(&mutex_);
+  for (int i = 0; i < data_.length(); ++i) {
+    delete data_[i];
+  }
+  data_.Clear();
+}
+
+
+// Assigns ids to the objects written into a message so that shared and
+// cyclic references are sent as back references rather than walked again.
+class SerializedObjectMap {
+ public:
+  SerializedObjectMap() : map_(Match) {}
+
+  // Returns the id of |object| if it has been written before.  Otherwise
+  // assigns it the next id and returns -1.
+  int LookupOrInsert(Handle<Object> object) {
+    int hash = object->GetIdentityHash();
+    i::HashMap::Entry* entry = map_.Lookup(
+        reinterpret_cast<void*>(static_cast<intptr_t>(hash)), hash, true);
+    // Objects with the same identity hash are chained through |next_|.
+    int head = static_cast<int>(reinterpret_cast<intptr_t>(entry->value)) - 1;
+    for (int id = head; id >= 0; id = next_[id]) {
+      if (objects_[id] == object) return id;
+    }
+    next_.Add(head);
+    objects_.Add(object);
+    entry->value = reinterpret_cast<void*>(
+        static_cast<intptr_t>(objects_.length()));
+    return -1;
+  }
+
+ private:
+  static bool Match(void* key1, void* key2) { return key1 == key2; }
+
+  i::HashMap map_;
+  i::List<Handle<Object> > objects_;
+  i::List<int> next_;
+};
+
+
+enum ArrayBufferViewType {
+  kArrayBufferViewDataView,
+  kArrayBufferViewInt8Array,
+  kArrayBufferViewUint8Array,
+  kArrayBufferViewUint8ClampedArray,
+  kArrayBufferViewInt16Array,
+  kArrayBufferViewUint16Array,
+  kArrayBufferViewInt32Array,
+  kArrayBufferViewUint32Array,
+  kArrayBufferViewFloat32Array,
+  kArrayBufferViewFloat64Array
+};
+
+
+static ArrayBufferViewType GetArrayBufferViewType(Handle<Value> value) {
+  if (value->IsInt8Array()) return kArrayBufferViewInt8Array;
+  if (value->IsUint8Array()) return kArrayBufferViewUint8Array;
+  if (value->IsUint8ClampedArray()) return kArrayBufferViewUint8ClampedArray;
+  if (value->IsInt16Array()) return kArrayBufferViewInt16Array;
+  if (value->IsUint16Array()) return kArrayBufferViewUint16Array;
+  if (value->IsInt32Array()) return kArrayBufferViewInt32Array;
+  if (value->IsUint32Array()) return kArrayBufferViewUint32Array;
+  if (value->IsFloat32Array()) return kArrayBufferViewFloat32Array;
+  if (value->IsFloat64Array()) return kArrayBufferViewFloat64Array;
+  ASSERT(value->IsDataView());
+  return kArrayBufferViewDataView;
+}
+
+
+static Local<Value> NewArrayBufferView(ArrayBufferViewType type,
+                                       Handle<v8::ArrayBuffer> buffer,
+                                       size_t byte_offset,
+                                       size_t length) {
+  switch (type) {
+    case kArrayBufferViewDataView:
+      return DataView::New(buffer, byte_offset, length);
+    case kArrayBufferViewInt8Array:
+      return Int8Array::New(buffer, byte_offset, length);
+    case kArrayBufferViewUint8Array:
+      return Uint8Array::New(buffer, byte_offset, length);
+    case kArrayBufferViewUint8ClampedArray:
+      return Uint8ClampedArray::New(buffer, byte_offset, length);
+    case kArrayBufferViewInt16Array:
+      return Int16Array::New(buffer, byte_offset, length);
+    case kArrayBufferViewUint16Array:
+      return Uint16Array::New(buffer, byte_offset, length);
+    case kArrayBufferViewInt32Array:
+      return Int32Array::New(buffer, byte_offset, length);
+    case kArrayBufferViewUint32Array:
+      return Uint32Array::New(buffer, byte_offset, length);
+    case kArrayBufferViewFloat32Array:
+      return Float32Array::New(buffer, byte_offset, length);
+    case kArrayBufferViewFloat64Array:
+      return Float64Array::New(buffer, byte_offset, length);
+  }
+  UNREACHABLE();
+  return Local<Value>();
+}
+
+
+// Copies the backing store of |buffer| into memory owned by the caller.
+static void* CopyArrayBufferContents(Handle<v8::ArrayBuffer> buffer,
+                                     size_t* byte_length) {
+  i::Handle<i::JSArrayBuffer> obj = Utils::OpenHandle(*buffer);
+  *byte_length = buffer->ByteLength();
+  void* data =
+      i::V8::ArrayBufferAllocator()->AllocateUninitialized(*byte_length);
+  if (*byte_length > 0) {
+    i::OS::MemCopy(data, obj->backing_store(), *byte_length);
+  }
+  return data;
+}
+
+
+// Wraps |data| in an ArrayBuffer that the isolate owns and frees with the
+// ArrayBuffer allocator, so that it can be transferred on again without a
+// copy.
+static Local<v8::ArrayBuffer> NewArrayBufferWithContents(Isolate* isolate,
+                                                         void* data,
+                                                         size_t byte_length) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  i::Handle<i::JSArrayBuffer> buffer = i_isolate->factory()->NewJSArrayBuffer();
+  i::Runtime::SetupArrayBuffer(i_isolate, buffer, false, data, byte_length);
+  isolate->AdjustAmountOfExternalAllocatedMemory(byte_length);
+  return Utils::ToLocal(buffer);
+}
+
+
+static void WriteString(Handle<String> string, SerializationData* out_data) {
+  String::Utf8Value utf8(string);
+  out_data->Write<int>(utf8.length());
+  out_data->WriteMemory(*utf8, utf8.length());
+}
+
+
+static Local<String> ReadString(Isolate* isolate,
+                                SerializationData* data,
+                                int* offset) {
+  int length = data->Read<int>(offset);
+  i::ScopedVector<char> buffer(length);
+  data->ReadMemory(buffer.start(), length, offset);
+  return String::NewFromUtf8(
+      isolate, buffer.start(), String::kNormalString, length);
+}
+
+
+static bool SerializeValue(Isolate* isolate,
+                           Handle<Value> value,
+                           const i::List<Handle<v8::ArrayBuffer> >& transfer,
+                           SerializedObjectMap* seen_objects,
+                           SerializationData* out_data) {
+  if (value->IsUndefined()) {
+    out_data->WriteTag(kSerializationTagUndefined);
+  } else if (value->IsNull()) {
+    out_data->WriteTag(kSerializationTagNull);
+  } else if (value->IsTrue()) {
+    out_data->WriteTag(kSerializationTagTrue);
+  } else if (value->IsFalse()) {
+    out_data->WriteTag(kSerializationTagFalse);
+  } else if (value->IsNumber()) {
+    out_data->WriteTag(kSerializationTagNumber);
+    out_data->Write<double>(value->NumberValue());
+  } else if (value->IsString()) {
+    out_data->WriteTag(kSerializationTagString);
+    WriteString(Handle<String>::Cast(value), out_data);
+  } else if (value->IsFunction() || value->IsSymbol()) {
+    Throw(isolate, "Value cannot be cloned");
+    return false;
+  } else if (value->IsObject()) {
+    Handle<Object> object = Handle<Object>::Cast(value);
+    int id = seen_objects->LookupOrInsert(object);
+    if (id >= 0) {
+      out_data->WriteTag(kSerializationTagObjectReference);
+      out_data->Write<int>(id);
+    } else if (value->IsArrayBuffer()) {
+      Handle<v8::ArrayBuffer> buffer = Handle<v8::ArrayBuffer>::Cast(value);
+      // Buffers in the transfer list occupy the first contents slots and
+      // are detached once the whole message has been written.
+      int index = -1;
+      for (int i = 0; i < transfer.length(); ++i) {
+        if (transfer[i] == buffer) index = i;
+      }
+      if (index < 0) {
+        size_t byte_length;
+        void* data = CopyArrayBufferContents(buffer, &byte_length);
+        index = out_data->AddArrayBufferContents(data, byte_length);
+      }
+      out_data->WriteTag(kSerializationTagArrayBuffer);
+      out_data->Write<int>(index);
+    } else if (value->IsArrayBufferView()) {
+      Handle<ArrayBufferView> view = Handle<ArrayBufferView>::Cast(value);
+      ArrayBufferViewType type = GetArrayBufferViewType(view);
+      size_t length = type == kArrayBufferViewDataView
+          ? view->ByteLength() : Handle<TypedArray>::Cast(view)->Length();
+      out_data->WriteTag(kSerializationTagArrayBufferView);
+      out_data->Write<int>(type);
+      out_data->Write<size_t>(view->ByteOffset());
+      out_data->Write<size_t>(length);
+      if (!SerializeValue(isolate, view->Buffer(), transfer, seen_objects,
+                          out_data)) {
+        return false;
+      }
+    } else if (value->IsArray()) {
+      Handle<Array> array = Handle<Array>::Cast(value);
+      uint32_t length = array->Length();
+      out_data->WriteTag(kSerializationTagArray);
+      out_data->Write<uint32_t>(length);
+      for (uint32_t i = 0; i < length; ++i) {
+        Local<Value> element_value = array->Get(i);
+        if (element_value.IsEmpty()) return false;
+        if (!SerializeValue(isolate, element_value, transfer, seen_objects,
+                            out_data)) {
+          return false;
+        }
+      }
+    } else {
+      Local<Array> property_names = object->GetOwnPropertyNames();
+      if (property_names.IsEmpty()) return false;
+      uint32_t length = property_names->Length();
+      out_data->WriteTag(kSerializationTagObject);
+      out_data->Write<uint32_t>(length);
+      for (uint32_t i = 0; i < length; ++i) {
+        Local<Value> name = property_names->Get(i);
+        if (name.IsEmpty()) return false;
+        Local<String> name_string = name->ToString();
+        if (name_string.IsEmpty()) return false;
+        Local<Value> property_value = object->Get(name_string);
+        if (property_value.IsEmpty()) return false;
+        WriteString(name_string, out_data);
+        if (!SerializeValue(isolate, property_value, transfer, seen_objects,
+                            out_data)) {
+          return false;
+        }
+      }
+    }
+  } else {
+    Throw(isolate, "Value cannot be cloned");
+    return false;
+  }
+  return true;
+}
+
+
+static Local<Value> DeserializeValue(Isolate* isolate,
+                                     SerializationData* data,
+                                     i::List<Local<Object> >* seen_objects,
+                                     int* offset) {
+  Local<Value> result;
+  SerializationTag tag = data->ReadTag(offset);
+  switch (tag) {
+    case kSerializationTagUndefined:
+      result = Undefined(isolate);
+      break;
+    case kSerializationTagNull:
+      result = Null(isolate);
+      break;
+    case kSerializationTagTrue:
+      result = True(isolate);
+      break;
+    case kSerializationTagFalse:
+      result = False(isolate);
+      break;
+    case kSerializationTagNumber:
+      result = Number::New(isolate, data->Read<double>(offset));
+      break;
+    case kSerializationTagString:
+      result = ReadString(isolate, data, offset);
+      break;
+    case kSerializationTagObjectReference:
+      result = seen_objects->at(data->Read<int>(offset));
+      break;
+    case kSerializationTagArrayBuffer: {
+      void* contents;
+      size_t byte_length;
+      data->ReadArrayBufferContents(data->Read<int>(offset), &contents,
+                                    &byte_length);
+      Local<v8::ArrayBuffer> buffer =
+          NewArrayBufferWithContents(isolate, contents, byte_length);
+      seen_objects->Add(buffer);
+      result = buffer;
+      break;
+    }
+    case kSerializationTagArrayBufferView: {
+      ArrayBufferViewType type =
+          static_cast<ArrayBufferViewType>(data->Read<int>(offset));
+      size_t byte_offset = data->Read<size_t>(offset);
+      size_t length = data->Read<size_t>(offset);
+      // Reserve the view's id before its buffer takes the next one.
+      int id = seen_objects->length();
+      seen_objects->Add(Local<Object>());
+      Local<Value> buffer =
+          DeserializeValue(isolate, data, seen_objects, offset);
+      Local<Object> view = Local<Object>::Cast(NewArrayBufferView(
+          type, Local<v8::ArrayBuffer>::Cast(buffer), byte_offset, length));
+      seen_objects->at(id) = view;
+      result = view;
+      break;
+    }
+    case kSerializationTagArray: {
+      uint32_t length = data->Read<uint32_t>(offset);
+      Local<Array> array = Array::New(isolate, length);
+      seen_objects->Add(array);
+      for (uint32_t i = 0; i < length; ++i) {
+        array->Set(i, DeserializeValue(isolate, data, seen_objects, offset));
+      }
+      result = array;
+      break;
+    }
+    case kSerializationTagObject: {
+      uint32_t length = data->Read<uint32_t>(offset);
+      Local<Object> object = Object::New(isolate);
+      seen_objects->Add(object);
+      for (uint32_t i = 0; i < length; ++i) {
+        Local<String> name = ReadString(isolate, data, offset);
+        object->Set(name,
+                    DeserializeValue(isolate, data, seen_objects, offset));
+      }
+      result = object;
+      break;
+    }
+  }
+  return result;
+}
+
+
+// Serializes the message and transfer list passed to a postMessage()
+// function.  Throws and returns NULL if the message cannot be cloned.
+static SerializationData* SerializeMessage(
+    const v8::FunctionCallbackInfo<v8::Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  if (args.Length() < 1) {
+    Throw(isolate, "Invalid argument");
+    return NULL;
+  }
+
+  i::List<Handle<v8::ArrayBuffer> > transfer;
+  if (args.Length() >= 2 && !args[1]->IsUndefined()) {
+    if (!args[1]->IsArray()) {
+      Throw(isolate, "Transfer list must be an Array");
+      return NULL;
+    }
+    Handle<Array> array = Handle<Array>::Cast(args[1]);
+    for (uint32_t i = 0; i < array->Length(); ++i) {
+      Local<Value> element = array->Get(i);
+      if (element.IsEmpty()) return NULL;
+      if (!element->IsArrayBuffer()) {
+        Throw(isolate, "Transfer list elements must be ArrayBuffers");
+        return NULL;
+      }
+      Handle<v8::ArrayBuffer> buffer = Handle<v8::ArrayBuffer>::Cast(element);
+      for (int j = 0; j < transfer.length(); ++j) {
+        if (transfer[j] == buffer) {
+          Throw(isolate, "ArrayBuffer occurs in the transfer list twice");
+          return NULL;
+        }
+      }
+      transfer.Add(buffer);
+    }
+  }
+
+  SerializationData* data = new SerializationData;
+  for (int i = 0; i < transfer.length(); ++i) {
+    data->AddArrayBufferContents(NULL, 0);
+  }
+  SerializedObjectMap seen_objects;
+  if (!SerializeValue(isolate, args[0], transfer, &seen_objects, data)) {
+    delete data;
+    return NULL;
+  }
+
+  // The message is complete, so the transferred buffers can be detached.
+  // Buffers whose memory is owned by the embedder have to be copied.
+  for (int i = 0; i < transfer.length(); ++i) {
+    Handle<v8::ArrayBuffer> buffer = transfer[i];
+    if (buffer->IsExternal()) {
+      size_t byte_length;
+      void* contents = CopyArrayBufferContents(buffer, &byte_length);
+      data->SetArrayBufferContents(i, contents, byte_length);
+    } else {
+      v8::ArrayBuffer::Contents contents = buffer->Externalize();
+      data->SetArrayBufferContents(i, contents.Data(), contents.ByteLength());
+      isolate->AdjustAmountOfExternalAllocatedMemory(
+          -static_cast<int64_t>(contents.ByteLength()));
+    }
+    buffer->Neuter();
+  }
+  return data;
+}
+
+
+static Local<Value> DeserializeMessage(Isolate* isolate,
+                                       SerializationData* data) {
+  EscapableHandleScope scope(isolate);
+  i::List<Local<Object> > seen_objects;
+  int offset = 0;
+  Local<Value> value = DeserializeValue(isolate, data, &seen_objects, &offset);
+  return scope.Escape(value);
+}
+
+
+Worker::Worker()
+    : in_semaphore_(0),
+      out_semaphore_(0),
+      thread_(NULL),
+      script_(NULL),
+      running_(false),
+      isolate_(NULL) {}
+
+
+Worker::~Worker() {
+  delete thread_;
+  thread_ = NULL;
+  delete[] script_;
+  script_ = NULL;
+}
+
+
+void Worker::StartExecuteInThread(const char* script) {
+  i::NoBarrier_Store(&running_, true);
+  script_ = i::StrDup(script);
+  thread_ = new WorkerThread(this);
+  thread_->Start();
+}
+
+
+void Worker::PostMessage(SerializationData* data) {
+  in_queue_.Enqueue(data);
+  in_semaphore_.Signal();
+}
+
+
+SerializationData* Worker::GetMessage() {
+  SerializationData* data = NULL;
+  while (!out_queue_.Dequeue(&data)) {
+    // The worker signals |out_semaphore_| one last time when it finishes, so
+    // it is safe to give up once the queue is drained.
+    if (!i::NoBarrier_Load(&running_)) break;
+    out_semaphore_.Wait();
+  }
+  return data;
+}
+
+
+void Worker::Terminate() {
+  i::NoBarrier_Store(&running_, false);
+  // Wake the message loop, and interrupt any script that is still running.
+  in_semaphore_.Signal();
+  i::LockGuard<i::Mutex> lock_guard(&isolate_mutex_);
+  if (isolate_ != NULL) V8::TerminateExecution(isolate_);
+}
+
+
+void Worker::WaitForThread() {
+  if (thread_ == NULL) return;
+  thread_->Join();
+}
+
+
+void Worker::ExecuteInThread() {
+  Isolate* isolate = Isolate::New();
+  {
+    i::LockGuard<i::Mutex> lock_guard(&isolate_mutex_);
+    isolate_ = isolate;
+  }
+  {
+    Isolate::Scope iscope(isolate);
+    Locker lock(isolate);
+    HandleScope scope(isolate);
+    PerIsolateData data(isolate);
+    Handle<ObjectTemplate> global_template =
+        Shell::CreateGlobalTemplate(isolate);
+    global_template->Set(
+        String::NewFromUtf8(isolate, "postMessage"),
+        FunctionTemplate::New(isolate, PostMessageOut,
+                              External::New(isolate, this)));
+    Local<Context> context = Context::New(isolate, NULL, global_template);
+    Context::Scope cscope(context);
+    PerIsolateData::RealmScope realm_scope(PerIsolateData::Get(isolate));
+
+    Handle<Object> global = context->Global();
+    Handle<String> file_name = String::NewFromUtf8(isolate, "unnamed");
+    Handle<String> source = String::NewFromUtf8(isolate, script_);
+    if (i::NoBarrier_Load(&running_) &&
+        Shell::ExecuteString(isolate, source, file_name, false, true)) {
+      // Hand every incoming message to the worker's onmessage function.
+      Handle<Value> onmessage =
+          global->Get(String::NewFromUtf8(isolate, "onmessage"));
+      if (onmessage->IsFunction()) {
+        Handle<Function> onmessage_fun = Handle<Function>::Cast(onmessage);
+        while (true) {
+          in_semaphore_.Wait();
+          if (!i::NoBarrier_Load(&running_)) break;
+          SerializationData* message;
+          if (!in_queue_.Dequeue(&message)) continue;
+          HandleScope scope(isolate);
+          Handle<Value> argv[] = { DeserializeMessage(isolate, message) };
+          delete message;
+          TryCatch try_catch;
+          onmessage_fun->Call(global, 1, argv);
+          if (try_catch.HasCaught()) {
+            if (!try_catch.CanContinue()) break;
+            Shell::ReportException(isolate, &try_catch);
+          }
+        }
+      }
+    }
+  }
+  {
+    i::LockGuard<i::Mutex> lock_guard(&isolate_mutex_);
+    isolate_ = NULL;
+  }
+  isolate->Dispose();
+
+  i::NoBarrier_Store(&running_, false);
+  out_semaphore_.Signal();
+}
+
+
+void Worker::PostMessageOut(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  HandleScope scope(isolate);
+  Worker* worker =
+      static_cast<Worker*>(Local<External>::Cast(args.Data())->Value());
+  SerializationData* data = SerializeMessage(args);
+  if (data == NULL) return;
+  worker->out_queue_.Enqueue(data);
+  worker->out_semaphore_.Signal();
+}
+
+
+static Worker* GetWorkerFromThis(
+    const v8::FunctionCallbackInfo<v8::Value>& args) {
+  if (args.This()->InternalFieldCount() != 1) {
+    Throw(args.GetIsolate(), "Receiver is not a Worker");
+    return NULL;
+  }
+  return static_cast<Worker*>(
+      args.This()->GetAlignedPointerFromInternalField(0));
+}
+
+
+void Shell::WorkerNew(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  HandleScope scope(isolate);
+  if (!args.IsConstructCall()) {
+    Throw(isolate, "Worker must be constructed with new");
+    return;
+  }
+  if (args.Length() < 1 || !args[0]->IsString()) {
+    Throw(isolate, "1st argument must be a string");
+    return;
+  }
+
+  Worker* worker = new Worker();
+  args.This()->SetAlignedPointerInInternalField(0, worker);
+  {
+    i::LockGuard<i::Mutex> lock_guard(&workers_mutex_);
+    workers_.Add(worker);
+  }
+  String::Utf8Value script(args[0]);
+  worker->StartExecuteInThread(*script);
+}
+
+
+void Shell::WorkerPostMessage(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  HandleScope scope(args.GetIsolate());
+  Worker* worker = GetWorkerFromThis(args);
+  if (worker == NULL) return;
+  SerializationData* data = SerializeMessage(args);
+  if (data != NULL) worker->PostMessage(data);
+}
+
+
+void Shell::WorkerGetMessage(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  HandleScope scope(isolate);
+  Worker* worker = GetWorkerFromThis(args);
+  if (worker == NULL) return;
+  SerializationData* data = worker->GetMessage();
+  if (data == NULL) return;
+  args.GetReturnValue().Set(DeserializeMessage(isolate, data));
+  delete data;
+}
+
+
+void Shell::WorkerTerminate(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  HandleScope scope(args.GetIsolate());
+  Worker* worker = GetWorkerFromThis(args);
+  if (worker == NULL) return;
+  worker->Terminate();
+}
+
+
+void Shell::CleanupWorkers() {
+  // Workers may start further workers while they are being shut down, so
+  // keep going until none are left.
+  while (true) {
+    i::List<Worker*> workers;
+    {
+      i::LockGuard<i::Mutex> lock_guard(&workers_mutex_);
+      if (workers_.is_empty()) break;
+      workers.AddAll(workers_);
+      workers_.Clear();
+    }
+    for (int i = 0; i < workers.length(); ++i) {
+      workers[i]->Terminate();
+      workers[i]->WaitForThread();
+      delete workers[i];
+    }
+  }
+}
 #endif  // V8_SHARED
 
 
@@ -1443,6 +2155,28 @@ bool Shell::SetOptions(int argc, char* argv[]) {
     } else if (strncmp(argv[i], "--icu-data-file=", 16) == 0) {
       options.icu_data_file = argv[i] + 16;
       argv[i] = NULL;
+    } else if (strncmp(argv[i], "--bench", 7) == 0) {
+#ifdef V8_SHARED
+      printf("D8 with shared library does not support benchmarking\n");
+      return false;
+#else
+      const char* arg = argv[i];
+      if (strcmp(arg, "--bench") == 0) {
+        options.bench = true;
+      } else if (strncmp(arg, "--bench-warmup=", 15) == 0) {
+        options.bench_warmup_runs = atoi(arg + 15);
+      } else if (strncmp(arg, "--bench-runs=", 13) == 0) {
+        options.bench_runs = atoi(arg + 13);
+      } else if (strcmp(arg, "--bench-gc") == 0) {
+        options.bench_gc = true;
+      } else if (strncmp(arg, "--bench-json=", 13) == 0) {
+        options.bench_json_file = arg + 13;
+      } else {
+        printf("Unknown benchmark option %s\n", arg);
+        return false;
+      }
+      argv[i] = NULL;
+#endif  // V8_SHARED
     }
 #ifdef V8_SHARED
     else if (strcmp(argv[i], "--dump-counters") == 0) {
@@ -1456,6 +2190,12 @@ bool Shell::SetOptions(int argc, char* argv[]) {
   }
 
 #ifndef V8_SHARED
+  if (options.bench &&
+      (options.bench_runs < 1 || options.bench_warmup_runs < 0)) {
+    printf("--bench requires at least one run and no negative warm-up\n");
+    return false;
+  }
+
   // Run parallel threads if we are not using --isolate
   options.parallel_files = new char*[options.num_parallel_files];
   int parallel_files_set = 0;
@@ -1570,6 +2310,156 @@ int Shell::RunMain(Isolate* isolate, int argc, char* argv[]) {
 }
 
 
+#ifndef V8_SHARED
+// Two-sided 95% quantiles of Student's t distribution for 1 to 30 degrees of
+// freedom. Larger samples use the normal approximation.
+static const double kStudentT95[] = {
+  12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+  2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+  2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+};
+
+
+struct BenchmarkStatistics {
+  double mean;
+  double median;
+  double p95;
+  double p99;
+  double stddev;
+  double ci95_low;
+  double ci95_high;
+};
+
+
+// Nearest-rank percentile of an ascending sample.
+static double Percentile(i::Vector<double> sorted, double fraction) {
+  int rank = static_cast<int>(std::ceil(fraction * sorted.length()));
+  return sorted[i::Max(rank, 1) - 1];
+}
+
+
+static BenchmarkStatistics ComputeBenchmarkStatistics(
+    i::Vector<double> samples) {
+  int n = samples.length();
+  i::ScopedVector<double> sorted(n);
+  double sum = 0;
+  for (int i = 0; i < n; i++) {
+    sorted[i] = samples[i];
+    sum += samples[i];
+  }
+  sorted.Sort();
+
+  BenchmarkStatistics stats;
+  stats.mean = sum / n;
+  stats.median = (n % 2 == 1)
+      ? sorted[n / 2]
+      : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+  stats.p95 = Percentile(sorted, 0.95);
+  stats.p99 = Percentile(sorted, 0.99);
+  double squares = 0;
+  for (int i = 0; i < n; i++) {
+    double deviation = samples[i] - stats.mean;
+    squares += deviation * deviation;
+  }
+  stats.stddev = n > 1 ? std::sqrt(squares / (n - 1)) : 0;
+  int df = n - 1;
+  double t = df < 1 ? 0 : df <= static_cast<int>(ARRAY_SIZE(kStudentT95))
+      ? kStudentT95[df - 1]
+      : 1.96;
+  double margin = t * stats.stddev / std::sqrt(static_cast<double>(n));
+  stats.ci95_low = stats.mean - margin;
+  stats.ci95_high = stats.mean + margin;
+  return stats;
+}
+
+
+static void WriteBenchmarkJSON(const char* file_name,
+                               const BenchmarkStatistics& stats,
+                               i::Vector<double> time_ms,
+                               i::Vector<int32_t> gc_ms,
+                               i::Vector<int32_t> compile_ms) {
+  FILE* file = i::OS::FOpen(file_name, "w");
+  if (file == NULL) {
+    printf("Could not open '%s' for writing\n", file_name);
+    return;
+  }
+  fprintf(file, "{\n");
+  fprintf(file, "  \"warmup_runs\": %d,\n", Shell::options.bench_warmup_runs);
+  fprintf(file, "  \"runs\": %d,\n", time_ms.length());
+  fprintf(file, "  \"mean_ms\": %.3f,\n", stats.mean);
+  fprintf(file, "  \"median_ms\": %.3f,\n", stats.median);
+  fprintf(file, "  \"p95_ms\": %.3f,\n", stats.p95);
+  fprintf(file, "  \"p99_ms\": %.3f,\n", stats.p99);
+  fprintf(file, "  \"stddev_ms\": %.3f,\n", stats.stddev);
+  fprintf(file, "  \"ci95_ms\": [%.3f, %.3f],\n",
+          stats.ci95_low, stats.ci95_high);
+  fprintf(file, "  \"samples\": [\n");
+  for (int i = 0; i < time_ms.length(); i++) {
+    fprintf(file,
+            "    {\"time_ms\": %.3f, \"gc_ms\": %d, \"compile_ms\": %d}%s\n",
+            time_ms[i], gc_ms[i], compile_ms[i],
+            i + 1 < time_ms.length() ? "," : "");
+  }
+  fprintf(file, "  ]\n");
+  fprintf(file, "}\n");
+  fclose(file);
+}
+
+
+int Shell::RunBenchmark(Isolate* isolate, int argc, char* argv[]) {
+  int warmup_runs = options.bench_warmup_runs;
+  int runs = options.bench_runs;
+  i::ScopedVector<double> time_ms(runs);
+  i::ScopedVector<int32_t> gc_ms(runs);
+  i::ScopedVector<int32_t> compile_ms(runs);
+  for (int i = 0; i < warmup_runs + runs; i++) {
+    if (options.bench_gc) {
+      Locker lock(isolate);
+      V8::LowMemoryNotification();
+    }
+    int32_t gc_before = HistogramTotal("V8.GCScavenger") +
+                        HistogramTotal("V8.GCCompactor");
+    int32_t compile_before = HistogramTotal("V8.Compile") +
+                             HistogramTotal("V8.CompileEval") +
+                             HistogramTotal("V8.CompileLazy");
+    options.last_run = (i == warmup_runs + runs - 1);
+    i::TimeTicks start = i::TimeTicks::HighResolutionNow();
+    int result = RunMain(isolate, argc, argv);
+    double elapsed = (i::TimeTicks::HighResolutionNow() - start)
+        .InMillisecondsF();
+    if (result != 0) return result;
+    int32_t gc = HistogramTotal("V8.GCScavenger") +
+                 HistogramTotal("V8.GCCompactor") - gc_before;
+    int32_t compile = HistogramTotal("V8.Compile") +
+                      HistogramTotal("V8.CompileEval") +
+                      HistogramTotal("V8.CompileLazy") - compile_before;
+    if (i < warmup_runs) {
+      printf("Warm-up %d/%d: %.3f ms (gc %d ms, compile %d ms)\n",
+             i + 1, warmup_runs, elapsed, gc, compile);
+    } else {
+      int run = i - warmup_runs;
+      time_ms[run] = elapsed;
+      gc_ms[run] = gc;
+      compile_ms[run] = compile;
+      printf("Run %d/%d: %.3f ms (gc %d ms, compile %d ms)\n",
+             run + 1, runs, elapsed, gc, compile);
+    }
+  }
+
+  BenchmarkStatistics stats = ComputeBenchmarkStatistics(time_ms);
+  printf("mean %.3f ms, median %.3f ms, p95 %.3f ms, p99 %.3f ms\n",
+         stats.mean, stats.median, stats.p95, stats.p99);
+  printf("stddev %.3f ms, 95%% confidence interval [%.3f, %.3f] ms\n",
+         stats.stddev, stats.ci95_low, stats.ci95_high);
+  if (options.bench_json_file != NULL) {
+    WriteBenchmarkJSON(options.bench_json_file, stats,
+                       time_ms, gc_ms, compile_ms);
+  }
+  return 0;
+}
+#endif  // V8_SHARED
+
+
 #ifdef V8_SHARED
 static void SetStandaloneFlagsViaCommandLine() {
   int fake_argc = 3;
@@ -1642,26 +2532,6 @@ static void DumpHeapConstants(i::Isolate* isolate) {
 #endif  // V8_SHARED
 
 
-class ShellArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
- public:
-  virtual void* Allocate(size_t length) {
-    void* result = malloc(length);
-    memset(result, 0, length);
-    return result;
-  }
-  virtual void* AllocateUninitialized(size_t length) {
-    return malloc(length);
-  }
-  virtual void Free(void* data, size_t) { free(data); }
-  // TODO(dslomov): Remove when v8:2823 is fixed.
-  virtual void Free(void* data) {
-#ifndef V8_SHARED
-    UNREACHABLE();
-#endif
-  }
-};
-
-
 class MockArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
  public:
   virtual void* Allocate(size_t) V8_OVERRIDE {
@@ -1684,12 +2554,13 @@ int Shell::Main(int argc, char* argv[]) {
 #else
   SetStandaloneFlagsViaCommandLine();
 #endif
-  ShellArrayBufferAllocator array_buffer_allocator;
+  v8::ArrayBuffer::Allocator* array_buffer_allocator =
+      v8::ArrayBuffer::Allocator::NewDefaultAllocator();
   MockArrayBufferAllocator mock_arraybuffer_allocator;
   if (options.mock_arraybuffer_allocator) {
     v8::V8::SetArrayBufferAllocator(&mock_arraybuffer_allocator);
   } else {
-    v8::V8::SetArrayBufferAllocator(&array_buffer_allocator);
+    v8::V8::SetArrayBufferAllocator(array_buffer_allocator);
   }
   int result = 0;
   Isolate* isolate = Isolate::GetCurrent();
@@ -1729,6 +2600,8 @@ int Shell::Main(int argc, char* argv[]) {
       printf("======== Full Deoptimization =======\n");
       Testing::DeoptimizeAll();
 #if !defined(V8_SHARED)
+    } else if (options.bench) {
+      result = RunBenchmark(isolate, argc, argv);
     } else if (i::FLAG_stress_runs > 0) {
       int stress_runs = i::FLAG_stress_runs;
       for (int i = 0; i < stress_runs && result == 0; i++) {
@@ -1764,7 +2637,11 @@ int Shell::Main(int argc, char* argv[]) {
       RunShell(isolate);
     }
   }
+#ifndef V8_SHARED
+  CleanupWorkers();
+#endif  // V8_SHARED
   V8::Dispose();
+  delete array_buffer_allocator;
 
   OnExit();
 
@@ -194,6 +194,129 @@ class SourceGroup {
 };
 
 
+#ifndef V8_SHARED
+enum SerializationTag {
+  kSerializationTagUndefined,
+  kSerializationTagNull,
+  kSerializationTagTrue,
+  kSerializationTagFalse,
+  kSerializationTagNumber,
+  kSerializationTagString,
+  kSerializationTagArray,
+  kSerializationTagObject,
+  kSerializationTagObjectReference,
+  kSerializationTagArrayBuffer,
+  kSerializationTagArrayBufferView
+};
+
+
+// A message passed between a worker and its parent.  Values are flattened
+// into a byte stream that does not reference either heap; ArrayBuffer
+// backing stores travel alongside it and are handed to the receiving isolate
+// without copying.
+class SerializationData {
+ public:
+  SerializationData() {}
+  ~SerializationData();
+
+  void WriteTag(SerializationTag tag) { data_.Add(static_cast<uint8_t>(tag)); }
+  void WriteMemory(const void* p, int length);
+  // Takes ownership of |data|, which must come from the ArrayBuffer
+  // allocator, and returns its index in this message.
+  int AddArrayBufferContents(void* data, size_t byte_length);
+  void SetArrayBufferContents(int index, void* data, size_t byte_length);
+
+  template <typename T>
+  void Write(const T& value) {
+    WriteMemory(&value, sizeof(value));
+  }
+
+  SerializationTag ReadTag(int* offset) const;
+  void ReadMemory(void* p, int length, int* offset) const;
+  // Hands ownership of the backing store at |index| to the caller.
+  void ReadArrayBufferContents(int index, void** data, size_t* byte_length);
+
+  template <typename T>
+  T Read(int* offset) const {
+    T value;
+    ReadMemory(&value, sizeof(value), offset);
+    return value;
+  }
+
+ private:
+  struct ArrayBufferContents {
+    void* data;
+    size_t byte_length;
+  };
+
+  i::List<uint8_t> data_;
+  i::List<ArrayBufferContents> array_buffer_contents_;
+
+  DISALLOW_COPY_AND_ASSIGN(SerializationData);
+};
+
+
+class SerializationDataQueue {
+ public:
+  ~SerializationDataQueue() { Clear(); }
+
+  void Enqueue(SerializationData* data);
+  bool Dequeue(SerializationData** data);
+  void Clear();
+
+ private:
+  i::Mutex mutex_;
+  i::List<SerializationData*> data_;
+};
+
+
+// A script running in its own isolate on its own thread.  The parent posts
+// messages into |in_queue_|, which the worker hands to its global onmessage
+// function; the worker's global postMessage fills |out_queue_|.
+class Worker {
+ public:
+  Worker();
+  ~Worker();
+
+  void StartExecuteInThread(const char* script);
+  // Takes ownership of |data|.
+  void PostMessage(SerializationData* data);
+  // Blocks until the worker posts a message.  Returns NULL once the worker
+  // has finished and all of its messages have been read.
+  SerializationData* GetMessage();
+  void Terminate();
+  void WaitForThread();
+
+ private:
+  class WorkerThread : public i::Thread {
+   public:
+    explicit WorkerThread(Worker* worker)
+        : i::Thread(i::Thread::Options("WorkerThread", 2 * i::MB)),
+          worker_(worker) {}
+
+    virtual void Run() { worker_->ExecuteInThread(); }
+
+   private:
+    Worker* worker_;
+  };
+
+  void ExecuteInThread();
+  static void PostMessageOut(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  i::Semaphore in_semaphore_;
+  i::Semaphore out_semaphore_;
+  SerializationDataQueue in_queue_;
+  SerializationDataQueue out_queue_;
+  i::Thread* thread_;
+  char* script_;
+  i::Atomic32 running_;
+  // Guards |isolate_| so that Terminate() can interrupt a running script.
+  i::Mutex isolate_mutex_;
+  Isolate* isolate_;
+};
+#endif  // V8_SHARED
+
+
 class BinaryResource : public v8::String::ExternalAsciiStringResource {
  public:
   BinaryResource(const char* string, int length)
@@ -232,6 +355,13 @@ class ShellOptions {
      dump_heap_constants(false),
      expected_to_throw(false),
      mock_arraybuffer_allocator(false),
+#ifndef V8_SHARED
+     bench(false),
+     bench_warmup_runs(3),
+     bench_runs(10),
+     bench_gc(false),
+     bench_json_file(NULL),
+#endif  // V8_SHARED
      num_isolates(1),
      isolate_sources(NULL),
      icu_data_file(NULL) { }
@@ -257,6 +387,13 @@ class ShellOptions {
   bool dump_heap_constants;
   bool expected_to_throw;
   bool mock_arraybuffer_allocator;
+#ifndef V8_SHARED
+  bool bench;
+  int bench_warmup_runs;
+  int bench_runs;
+  bool bench_gc;
+  const char* bench_json_file;
+#endif  // V8_SHARED
   int num_isolates;
   SourceGroup* isolate_sources;
   const char* icu_data_file;
@@ -279,6 +416,9 @@ class Shell : public i::AllStatic {
   static Handle<String> ReadFile(Isolate* isolate, const char* name);
   static Local<Context> CreateEvaluationContext(Isolate* isolate);
   static int RunMain(Isolate* isolate, int argc, char* argv[]);
+#ifndef V8_SHARED
+  static int RunBenchmark(Isolate* isolate, int argc, char* argv[]);
+#endif  // V8_SHARED
   static int Main(int argc, char* argv[]);
   static void Exit(int exit_code);
   static void OnExit();
@@ -304,6 +444,13 @@ class Shell : public i::AllStatic {
 #endif  // ENABLE_DEBUGGER_SUPPORT
 
   static void PerformanceNow(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  static void WorkerNew(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void WorkerPostMessage(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void WorkerGetMessage(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void WorkerTerminate(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void CleanupWorkers();
 #endif  // V8_SHARED
 
   static void RealmCurrent(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -399,7 +546,12 @@ class Shell : public i::AllStatic {
   static const i::TimeTicks kInitialTicks;
 
   static Counter* GetCounter(const char* name, bool is_histogram);
+  static int32_t HistogramTotal(const char* name);
   static void InstallUtilityScript(Isolate* isolate);
+
+  static i::Mutex workers_mutex_;
+  static i::List<Worker*> workers_;
+  friend class Worker;
 #endif  // V8_SHARED
   static void Initialize(Isolate* isolate);
   static void InitializeDebugger(Isolate* isolate);
@@ -55,26 +55,13 @@ void DateCache::ResetDateCache() {
     stamp_ = Smi::FromInt(stamp_->value() + 1);
   }
   ASSERT(stamp_ != Smi::FromInt(kInvalidStamp));
-  for (int i = 0; i < kDSTSize; ++i) {
-    ClearSegment(&dst_[i]);
-  }
-  dst_usage_counter_ = 0;
-  before_ = &dst_[0];
-  after_ = &dst_[1];
+  ClearDSTChunks();
   local_offset_ms_ = kInvalidLocalOffsetInMs;
   ymd_valid_ = false;
   OS::ClearTimezoneCache(tz_cache_);
 }
 
 
-void DateCache::ClearSegment(DST* segment) {
-  segment->start_sec = kMaxEpochTimeInSec;
-  segment->end_sec = -kMaxEpochTimeInSec;
-  segment->offset_ms = 0;
-  segment->last_used = 0;
-}
-
-
 void DateCache::YearMonthDayFromDays(
     int days, int* year, int* month, int* day) {
   if (ymd_valid_) {
@@ -200,186 +187,83 @@ int DateCache::DaysFromYearMonth(int year, int month) {
 }
 
 
-void DateCache::ExtendTheAfterSegment(int time_sec, int offset_ms) {
-  if (after_->offset_ms == offset_ms &&
-      after_->start_sec <= time_sec + kDefaultDSTDeltaInSec &&
-      time_sec <= after_->end_sec) {
-    // Extend the after_ segment.
-    after_->start_sec = time_sec;
-  } else {
-    // The after_ segment is either invalid or starts too late.
-    if (after_->start_sec <= after_->end_sec) {
-      // If the after_ segment is valid, replace it with a new segment.
-      after_ = LeastRecentlyUsedDST(before_);
-    }
-    after_->start_sec = time_sec;
-    after_->end_sec = time_sec;
-    after_->offset_ms = offset_ms;
-    after_->last_used = ++dst_usage_counter_;
-  }
-}
-
-
 int DateCache::DaylightSavingsOffsetInMs(int64_t time_ms) {
   int time_sec = (time_ms >= 0 && time_ms <= kMaxEpochTimeInMs)
       ? static_cast<int>(time_ms / 1000)
       : static_cast<int>(EquivalentTime(time_ms) / 1000);
-
-  // Invalidate cache if the usage counter is close to overflow.
-  // Note that dst_usage_counter is incremented less than ten times
-  // in this function.
-  if (dst_usage_counter_ >= kMaxInt - 10) {
-    dst_usage_counter_ = 0;
-    for (int i = 0; i < kDSTSize; ++i) {
-      ClearSegment(&dst_[i]);
-    }
-  }
-
-  // Optimistic fast check.
-  if (before_->start_sec <= time_sec &&
-      time_sec <= before_->end_sec) {
-    // Cache hit.
-    before_->last_used = ++dst_usage_counter_;
-    return before_->offset_ms;
-  }
-
-  ProbeDST(time_sec);
-
-  ASSERT(InvalidSegment(before_) || before_->start_sec <= time_sec);
-  ASSERT(InvalidSegment(after_) || time_sec < after_->start_sec);
-
-  if (InvalidSegment(before_)) {
-    // Cache miss.
-    before_->start_sec = time_sec;
-    before_->end_sec = time_sec;
-    before_->offset_ms = GetDaylightSavingsOffsetFromOS(time_sec);
-    before_->last_used = ++dst_usage_counter_;
-    return before_->offset_ms;
-  }
-
-  if (time_sec <= before_->end_sec) {
-    // Cache hit.
-    before_->last_used = ++dst_usage_counter_;
-    return before_->offset_ms;
-  }
-
-  if (time_sec > before_->end_sec + kDefaultDSTDeltaInSec) {
-    // If the before_ segment ends too early, then just
-    // query for the offset of the time_sec
-    int offset_ms = GetDaylightSavingsOffsetFromOS(time_sec);
-    ExtendTheAfterSegment(time_sec, offset_ms);
-    // This swap helps the optimistic fast check in subsequent invocations.
-    DST* temp = before_;
-    before_ = after_;
-    after_ = temp;
-    return offset_ms;
-  }
-
-  // Now the time_sec is between
-  // before_->end_sec and before_->end_sec + default DST delta.
-  // Update the usage counter of before_ since it is going to be used.
-  before_->last_used = ++dst_usage_counter_;
-
-  // Check if after_ segment is invalid or starts too late.
-  // Note that start_sec of invalid segments is kMaxEpochTimeInSec.
-  if (before_->end_sec + kDefaultDSTDeltaInSec <= after_->start_sec) {
-    int new_after_start_sec = before_->end_sec + kDefaultDSTDeltaInSec;
-    int new_offset_ms = GetDaylightSavingsOffsetFromOS(new_after_start_sec);
-    ExtendTheAfterSegment(new_after_start_sec, new_offset_ms);
-  } else {
-    ASSERT(!InvalidSegment(after_));
-    // Update the usage counter of after_ since it is going to be used.
-    after_->last_used = ++dst_usage_counter_;
-  }
-
-  // Now the time_sec is between before_->end_sec and after_->start_sec.
-  // Only one daylight savings offset change can occur in this interval.
-
-  if (before_->offset_ms == after_->offset_ms) {
-    // Merge two segments if they have the same offset.
-    before_->end_sec = after_->end_sec;
-    ClearSegment(after_);
-    return before_->offset_ms;
-  }
-
-  // Binary search for daylight savings offset change point,
-  // but give up if we don't find it in four iterations.
-  for (int i = 4; i >= 0; --i) {
-    int delta = after_->start_sec - before_->end_sec;
-    int middle_sec = (i == 0) ? time_sec : before_->end_sec + delta / 2;
-    int offset_ms = GetDaylightSavingsOffsetFromOS(middle_sec);
-    if (before_->offset_ms == offset_ms) {
-      before_->end_sec = middle_sec;
-      if (time_sec <= before_->end_sec) {
-        return offset_ms;
-      }
+  ASSERT(time_sec >= 0);
+
+  int index = time_sec >> kDSTChunkBits;
+  DSTChunk* chunk = dst_chunks_[index];
+  if (chunk == NULL) chunk = ComputeDSTChunk(index);
+
+  // Find the last transition that starts at or before time_sec.
+  int low = 0;
+  int high = chunk->length - 1;
+  while (low < high) {
+    int middle = low + (high - low + 1) / 2;
+    if (chunk->transitions[middle].start_sec <= time_sec) {
+      low = middle;
     } else {
-      ASSERT(after_->offset_ms == offset_ms);
-      after_->start_sec = middle_sec;
-      if (time_sec >= after_->start_sec) {
-        // This swap helps the optimistic fast check in subsequent invocations.
-        DST* temp = before_;
-        before_ = after_;
-        after_ = temp;
-        return offset_ms;
-      }
+      high = middle - 1;
     }
   }
-  UNREACHABLE();
-  return 0;
+  ASSERT(chunk->transitions[low].start_sec <= time_sec);
+  return chunk->transitions[low].offset_ms;
 }
 
 
-void DateCache::ProbeDST(int time_sec) {
-  DST* before = NULL;
-  DST* after = NULL;
-  ASSERT(before_ != after_);
-
-  for (int i = 0; i < kDSTSize; ++i) {
-    if (dst_[i].start_sec <= time_sec) {
-      if (before == NULL || before->start_sec < dst_[i].start_sec) {
-        before = &dst_[i];
-      }
-    } else if (time_sec < dst_[i].end_sec) {
-      if (after == NULL || after->end_sec > dst_[i].end_sec) {
-        after = &dst_[i];
+DateCache::DSTChunk* DateCache::ComputeDSTChunk(int index) {
+  ASSERT(index >= 0 && index < kDSTChunkCount);
+  ASSERT(dst_chunks_[index] == NULL);
+  int start_sec = index << kDSTChunkBits;
+  int end_sec = static_cast<int>(
+      Min(static_cast<int64_t>(kMaxEpochTimeInSec),
+          (static_cast<int64_t>(index + 1) << kDSTChunkBits) - 1));
+
+  DSTChunk* chunk = new DSTChunk;
+  int offset_ms = GetDaylightSavingsOffsetFromOS(start_sec);
+  chunk->transitions[0].start_sec = start_sec;
+  chunk->transitions[0].offset_ms = offset_ms;
+  chunk->length = 1;
+
+  int sample_sec = start_sec;
+  while (sample_sec < end_sec) {
+    int next_sec = (end_sec - sample_sec > kDefaultDSTDeltaInSec)
+        ? sample_sec + kDefaultDSTDeltaInSec
+        : end_sec;
+    int next_offset_ms = GetDaylightSavingsOffsetFromOS(next_sec);
+    if (next_offset_ms != offset_ms) {
+      // Binary search for the first second that has the new offset.
+      int low_sec = sample_sec;
+      int high_sec = next_sec;
+      while (high_sec - low_sec > 1) {
+        int middle_sec = low_sec + (high_sec - low_sec) / 2;
+        if (GetDaylightSavingsOffsetFromOS(middle_sec) == offset_ms) {
+          low_sec = middle_sec;
+        } else {
+          high_sec = middle_sec;
+        }
       }
+      ASSERT(chunk->length < kMaxDSTTransitionsPerChunk);
+      chunk->transitions[chunk->length].start_sec = high_sec;
+      chunk->transitions[chunk->length].offset_ms = next_offset_ms;
+      chunk->length++;
+      offset_ms = next_offset_ms;
     }
+    sample_sec = next_sec;
   }
 
-  // If before or after segments were not found,
-  // then set them to any invalid segment.
-  if (before == NULL) {
-    before = InvalidSegment(before_) ? before_ : LeastRecentlyUsedDST(after);
-  }
-  if (after == NULL) {
-    after = InvalidSegment(after_) && before != after_
-            ? after_ : LeastRecentlyUsedDST(before);
-  }
-
-  ASSERT(before != NULL);
-  ASSERT(after != NULL);
-  ASSERT(before != after);
-  ASSERT(InvalidSegment(before) || before->start_sec <= time_sec);
-  ASSERT(InvalidSegment(after) || time_sec < after->start_sec);
-  ASSERT(InvalidSegment(before) || InvalidSegment(after) ||
-         before->end_sec < after->start_sec);
-
-  before_ = before;
-  after_ = after;
+  dst_chunks_[index] = chunk;
+  return chunk;
 }
 
 
-DateCache::DST* DateCache::LeastRecentlyUsedDST(DST* skip) {
-  DST* result = NULL;
-  for (int i = 0; i < kDSTSize; ++i) {
-    if (&dst_[i] == skip) continue;
-    if (result == NULL || result->last_used > dst_[i].last_used) {
-      result = &dst_[i];
-    }
+void DateCache::ClearDSTChunks() {
+  for (int i = 0; i < kDSTChunkCount; ++i) {
+    delete dst_chunks_[i];
+    dst_chunks_[i] = NULL;
   }
-  ClearSegment(result);
-  return result;
 }
 
 } }  // namespace v8::internal
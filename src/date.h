@@ -63,10 +63,14 @@ class DateCache {
   static const int kInvalidStamp = -1;
 
   DateCache() : stamp_(0), tz_cache_(OS::CreateTimezoneCache()) {
+    for (int i = 0; i < kDSTChunkCount; ++i) {
+      dst_chunks_[i] = NULL;
+    }
     ResetDateCache();
   }
 
   virtual ~DateCache() {
+    ClearDSTChunks();
     OS::DisposeTimezoneCache(tz_cache_);
     tz_cache_ = NULL;
   }
@@ -202,51 +206,45 @@ class DateCache {
   // September 30.
   static const int kDefaultDSTDeltaInSec = 19 * kSecPerDay;
 
-  // Size of the Daylight Savings Time cache.
-  static const int kDSTSize = 32;
-
-  // Daylight Savings Time segment stores a segment of time where
-  // daylight savings offset does not change.
-  struct DST {
+  // The daylight savings offsets of [0, kMaxEpochTimeInSec] are tabulated
+  // lazily in chunks of 2^kDSTChunkBits seconds (about 388 days). Times
+  // outside of that range are mapped into it by EquivalentTime().
+  static const int kDSTChunkBits = 25;
+  static const int kDSTChunkCount = (kMaxEpochTimeInSec >> kDSTChunkBits) + 1;
+  // A chunk is sampled every kDefaultDSTDeltaInSec, and every sampling
+  // interval contributes at most one transition.
+  static const int kMaxDSTTransitionsPerChunk =
+      (1 << kDSTChunkBits) / kDefaultDSTDeltaInSec + 2;
+
+  // Daylight savings offset in effect from start_sec up to the start of the
+  // next transition.
+  struct DSTTransition {
     int start_sec;
-    int end_sec;
     int offset_ms;
-    int last_used;
+  };
+
+  // Transitions of one chunk, sorted by start_sec. The first transition
+  // starts at the beginning of the chunk.
+  struct DSTChunk {
+    int length;
+    DSTTransition transitions[kMaxDSTTransitionsPerChunk];
   };
 
   // Computes the daylight savings offset for the given time.
   // ECMA 262 - 15.9.1.8
   int DaylightSavingsOffsetInMs(int64_t time_ms);
 
-  // Sets the before_ and the after_ segments from the DST cache such that
-  // the before_ segment starts earlier than the given time and
-  // the after_ segment start later than the given time.
-  // Both segments might be invalid.
-  // The last_used counters of the before_ and after_ are updated.
-  void ProbeDST(int time_sec);
+  // Queries the OS for the transitions of the given chunk.
+  DSTChunk* ComputeDSTChunk(int index);
 
-  // Finds the least recently used segment from the DST cache that is not
-  // equal to the given 'skip' segment.
-  DST* LeastRecentlyUsedDST(DST* skip);
-
-  // Extends the after_ segment with the given point or resets it
-  // if it starts later than the given time + kDefaultDSTDeltaInSec.
-  inline void ExtendTheAfterSegment(int time_sec, int offset_ms);
-
-  // Makes the given segment invalid.
-  inline void ClearSegment(DST* segment);
-
-  bool InvalidSegment(DST* segment) {
-    return segment->start_sec > segment->end_sec;
-  }
+  // Frees all tabulated transitions.
+  void ClearDSTChunks();
 
   Smi* stamp_;
 
-  // Daylight Saving Time cache.
-  DST dst_[kDSTSize];
-  int dst_usage_counter_;
-  DST* before_;
-  DST* after_;
+  // Daylight savings transition table. DateCache is owned by an isolate, so
+  // the table is only ever accessed from the thread that runs it.
+  DSTChunk* dst_chunks_[kDSTChunkCount];
 
   int local_offset_ms_;
 
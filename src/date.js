@@ -272,6 +272,8 @@ var parse_buffer = $Array(8);
 function DateParse(string) {
   var arr = %DateParseString(ToString(string), parse_buffer);
   if (IS_NULL(arr)) return NAN;
+  // Strict ISO date-time strings come back as the time value.
+  if (IS_NUMBER(arr)) return arr;
 
   var day = MakeDay(arr[0], arr[1], arr[2]);
   var time = MakeTime(arr[3], arr[4], arr[5], arr[6]);
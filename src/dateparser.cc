@@ -29,9 +29,77 @@
 
 #include "dateparser.h"
 
+#include "date.h"
+
 namespace v8 {
 namespace internal {
 
+// Reads the decimal number in str[start, start + length). Returns -1 if any
+// of the characters is not a digit.
+static int ReadFixedDigits(Vector<const uint8_t> str, int start, int length) {
+  int value = 0;
+  for (int i = start; i < start + length; i++) {
+    int digit = str[i] - '0';
+    if (static_cast<unsigned>(digit) > 9) return -1;
+    value = value * 10 + digit;
+  }
+  return value;
+}
+
+
+bool DateParser::ParseISODateTime(Vector<const uint8_t> str,
+                                  DateCache* date_cache,
+                                  double* time) {
+  static const int kDateLength = 10;        // YYYY-MM-DD
+  static const int kDateTimeLength = 20;    // YYYY-MM-DDTHH:mm:ssZ
+  static const int kDateTimeMsLength = 24;  // YYYY-MM-DDTHH:mm:ss.sssZ
+  int length = str.length();
+  if (length != kDateLength &&
+      length != kDateTimeLength &&
+      length != kDateTimeMsLength) {
+    return false;
+  }
+  if (str[4] != '-' || str[7] != '-') return false;
+  int year = ReadFixedDigits(str, 0, 4);
+  int month = ReadFixedDigits(str, 5, 2);
+  int day = ReadFixedDigits(str, 8, 2);
+  if (year < 0 || !DayComposer::IsMonth(month) || !DayComposer::IsDay(day)) {
+    return false;
+  }
+
+  int hour = 0;
+  int minute = 0;
+  int second = 0;
+  int millisecond = 0;
+  if (length != kDateLength) {
+    if (str[10] != 'T' || str[13] != ':' || str[16] != ':' ||
+        str[length - 1] != 'Z') {
+      return false;
+    }
+    hour = ReadFixedDigits(str, 11, 2);
+    minute = ReadFixedDigits(str, 14, 2);
+    second = ReadFixedDigits(str, 17, 2);
+    if (length == kDateTimeMsLength) {
+      if (str[19] != '.') return false;
+      millisecond = ReadFixedDigits(str, 20, 3);
+    }
+    // Hour 24 is left to the general parser.
+    if (!TimeComposer::IsHour(hour) || !TimeComposer::IsMinute(minute) ||
+        !TimeComposer::IsSecond(second) ||
+        !TimeComposer::IsMillisecond(millisecond)) {
+      return false;
+    }
+  }
+
+  // Days past the end of the month roll over, as in MakeDay.
+  int days = date_cache->DaysFromYearMonth(year, month - 1) + day - 1;
+  int time_in_day_ms =
+      ((hour * 60 + minute) * 60 + second) * 1000 + millisecond;
+  *time = static_cast<double>(days) * DateCache::kMsPerDay + time_in_day_ms;
+  return true;
+}
+
+
 bool DateParser::DayComposer::Write(FixedArray* output) {
   if (index_ < 1) return false;
   // Day and month defaults to 1.
@@ -34,6 +34,8 @@
 namespace v8 {
 namespace internal {
 
+class DateCache;
+
 class DateParser : public AllStatic {
  public:
   // Parse the string as a date. If parsing succeeds, return true after
@@ -50,6 +52,15 @@ class DateParser : public AllStatic {
   template <typename Char>
   static bool Parse(Vector<Char> str, FixedArray* output, UnicodeCache* cache);
 
+  // Parse the fixed-layout ES5 forms YYYY-MM-DD, YYYY-MM-DDTHH:mm:ssZ and
+  // YYYY-MM-DDTHH:mm:ss.sssZ without tokenizing the string. If parsing
+  // succeeds, return true after storing the UTC time value in *time.
+  // Anything else, including fields out of range, returns false and has to
+  // go through Parse.
+  static bool ParseISODateTime(Vector<const uint8_t> str,
+                               DateCache* date_cache,
+                               double* time);
+
   enum {
     YEAR, MONTH, DAY, HOUR, MINUTE, SECOND, MILLISECOND, UTC_OFFSET, OUTPUT_SIZE
   };
@@ -352,10 +363,10 @@ class DateParser : public AllStatic {
     static bool IsMinute(int x) { return Between(x, 0, 59); }
     static bool IsHour(int x) { return Between(x, 0, 23); }
     static bool IsSecond(int x) { return Between(x, 0, 59); }
+    static bool IsMillisecond(int x) { return Between(x, 0, 999); }
 
    private:
     static bool IsHour12(int x) { return Between(x, 0, 12); }
-    static bool IsMillisecond(int x) { return Between(x, 0, 999); }
 
     static const int kSize = 4;
     int comp_[kSize];
@@ -147,8 +147,6 @@ class Execution V8_FINAL : public AllStatic {
                                                   Handle<Object> object,
                                                   bool* has_pending_exception);
 
-  static void RunMicrotasks(Isolate* isolate);
-  static void EnqueueMicrotask(Isolate* isolate, Handle<Object> microtask);
 };
 
 
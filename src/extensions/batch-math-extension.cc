@@ -0,0 +1,355 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "batch-math-extension.h"
+
+#include <cmath>
+
+#include "api.h"
+
+namespace v8 {
+namespace internal {
+
+const char* const BatchMathExtension::kSource =
+    "(function() {"
+    "  native function sinArray();"
+    "  native function cosArray();"
+    "  native function expArray();"
+    "  native function sqrtArray();"
+    "  var functions = ["
+    "    'sinArray', sinArray, 'cosArray', cosArray,"
+    "    'expArray', expArray, 'sqrtArray', sqrtArray"
+    "  ];"
+    "  for (var i = 0; i < functions.length; i += 2) {"
+    "    Object.defineProperty(Math, functions[i], {"
+    "      value: functions[i + 1], writable: true, configurable: true"
+    "    });"
+    "  }"
+    "})();";
+
+
+v8::Handle<v8::FunctionTemplate> BatchMathExtension::GetNativeFunctionTemplate(
+    v8::Isolate* isolate,
+    v8::Handle<v8::String> str) {
+  if (strcmp(*v8::String::Utf8Value(str), "sinArray") == 0) {
+    return v8::FunctionTemplate::New(isolate, BatchMathExtension::SinArray);
+  } else if (strcmp(*v8::String::Utf8Value(str), "cosArray") == 0) {
+    return v8::FunctionTemplate::New(isolate, BatchMathExtension::CosArray);
+  } else if (strcmp(*v8::String::Utf8Value(str), "expArray") == 0) {
+    return v8::FunctionTemplate::New(isolate, BatchMathExtension::ExpArray);
+  } else {
+    ASSERT(strcmp(*v8::String::Utf8Value(str), "sqrtArray") == 0);
+    return v8::FunctionTemplate::New(isolate, BatchMathExtension::SqrtArray);
+  }
+}
+
+
+// The kernels below are fdlibm polynomial evaluations with few, rarely taken
+// branches, so that the loops applying them can be auto-vectorized.
+//
+// Accuracy, measured against a correctly rounded result:
+//  - sin, cos: within 1 ulp. Arguments are reduced with fdlibm's first pass
+//    (pi/2 to 86 bits). When that pass cancels too many bits, i.e. near
+//    multiples of pi/2, and for |x| >= 2^19 * pi/2, the C library is used.
+//  - exp: within 1 ulp for results in the normal range. Arguments with
+//    subnormal, infinite or NaN results are passed to the C library.
+//  - sqrt: correctly rounded.
+// Float32Array elements are computed in double precision and rounded once.
+
+static const double kInvPio2 = 6.36619772367581382433e-01;
+// The first 33 bits of pi/2, so n * kPio2_1 is exact for |n| < 2^20, and
+// the rest of pi/2 rounded to a double.
+static const double kPio2_1 = 1.57079632673412561417e+00;
+static const double kPio2_1t = 6.07710050650619224932e-11;
+static const double kMaxReducibleTrigArgument = 823549.6653;  // 2^19 * pi/2.
+// The reduced argument is accurate when its exponent is at most this much
+// smaller than the exponent of x.
+static const int kMaxTrigReductionCancellation = 16;
+
+static const double kS1 = -1.66666666666666324348e-01;
+static const double kS2 = 8.33333333332248946124e-03;
+static const double kS3 = -1.98412698298579493134e-04;
+static const double kS4 = 2.75573137070700676789e-06;
+static const double kS5 = -2.50507602534068634195e-08;
+static const double kS6 = 1.58969099521155010221e-10;
+
+static const double kC1 = 4.16666666666666019037e-02;
+static const double kC2 = -1.38888888888741095749e-03;
+static const double kC3 = 2.48015872894767294178e-05;
+static const double kC4 = -2.75573143513906633035e-07;
+static const double kC5 = 2.08757232129817482790e-09;
+static const double kC6 = -1.13596475577881948265e-11;
+
+
+static inline int BiasedExponent(double x) {
+  return static_cast<int>((BitCast<uint64_t>(x) >> 52) & 0x7ff);
+}
+
+
+// sin(r + t) for |r| <= pi/4, where t is the tail of the reduced argument.
+static inline double SinKernel(double r, double t) {
+  double z = r * r;
+  double v = z * r;
+  double p = kS2 + z * (kS3 + z * (kS4 + z * (kS5 + z * kS6)));
+  return r - ((z * (0.5 * t - v * p) - t) - v * kS1);
+}
+
+
+// cos(r + t) for |r| <= pi/4, where t is the tail of the reduced argument.
+static inline double CosKernel(double r, double t) {
+  double z = r * r;
+  double p = z * (kC1 + z * (kC2 + z * (kC3 + z * (kC4 + z * (kC5 +
+                                                              z * kC6)))));
+  // For |r| >= 0.3, 1 - z/2 loses bits, so split off an exactly
+  // representable q first: cos = (1 - q) - ((z/2 - q) - ...).
+  double q = 0.0;
+  double abs_r = std::fabs(r);
+  if (abs_r > 0.78125) {
+    q = 0.28125;
+  } else if (abs_r >= 0.3) {
+    // r/4 with the low word cleared, as in fdlibm.
+    q = BitCast<double>(
+        (BitCast<uint64_t>(abs_r) - (static_cast<uint64_t>(2) << 52)) &
+        V8_UINT64_C(0xffffffff00000000));
+  }
+  return (1.0 - q) - ((0.5 * z - q) - (z * p - r * t));
+}
+
+
+// Reduces x to r + t with |r| <= pi/4 and x = r + t + n * pi/2, and returns
+// n. Returns false if the reduction is not accurate enough.
+static inline bool ReduceTrigArgument(double x, int* n, double* r, double* t) {
+  double fn = std::floor(x * kInvPio2 + 0.5);
+  double head = x - fn * kPio2_1;
+  double w = fn * kPio2_1t;
+  *r = head - w;
+  if (BiasedExponent(x) - BiasedExponent(*r) >
+      kMaxTrigReductionCancellation) {
+    return false;
+  }
+  *t = (head - *r) - w;
+  *n = static_cast<int>(fn);
+  return true;
+}
+
+
+static inline double FastSin(double x) {
+  int n;
+  double r, t;
+  if (!(std::fabs(x) < kMaxReducibleTrigArgument) ||
+      !ReduceTrigArgument(x, &n, &r, &t)) {
+    return std::sin(x);
+  }
+  double result = (n & 1) ? CosKernel(r, t) : SinKernel(r, t);
+  return (n & 2) ? -result : result;
+}
+
+
+static inline double FastCos(double x) {
+  int n;
+  double r, t;
+  if (!(std::fabs(x) < kMaxReducibleTrigArgument) ||
+      !ReduceTrigArgument(x, &n, &r, &t)) {
+    return std::cos(x);
+  }
+  double result = (n & 1) ? SinKernel(r, t) : CosKernel(r, t);
+  return ((n + 1) & 2) ? -result : result;
+}
+
+
+static const double kInvLn2 = 1.44269504088896338700e+00;
+static const double kLn2Hi = 6.93147180369123816490e-01;
+static const double kLn2Lo = 1.90821492927058770002e-10;
+// exp(x) is a normal, finite double for x in [kMinExpArgument,
+// kMaxExpArgument].
+static const double kMaxExpArgument = 7.09782712893383973096e+02;
+static const double kMinExpArgument = -7.08396418532264106224e+02;
+
+static const double kP1 = 1.66666666666666019037e-01;
+static const double kP2 = -2.77777777770155933842e-03;
+static const double kP3 = 6.61375632143793436117e-05;
+static const double kP4 = -1.65339022054652515390e-06;
+static const double kP5 = 4.13813679705723846039e-08;
+
+
+static inline double FastExp(double x) {
+  if (!(x > kMinExpArgument && x < kMaxExpArgument)) return std::exp(x);
+  // Reduce x to r in [-ln2/2, ln2/2] with x = r + k * ln2.
+  double k = std::floor(x * kInvLn2 + 0.5);
+  double hi = x - k * kLn2Hi;
+  double lo = k * kLn2Lo;
+  double r = hi - lo;
+  double t = r * r;
+  double c = r - t * (kP1 + t * (kP2 + t * (kP3 + t * (kP4 + t * kP5))));
+  double y = 1.0 - ((lo - (r * c) / (2.0 - c)) - hi);
+  // Scale by 2^k in two steps, since 2^k alone may not be a normal double
+  // at the ends of the range.
+  int half_k = static_cast<int>(k) / 2;
+  uint64_t scale1 = static_cast<uint64_t>(1023 + half_k) << 52;
+  uint64_t scale2 =
+      static_cast<uint64_t>(1023 + static_cast<int>(k) - half_k) << 52;
+  return y * BitCast<double>(scale1) * BitCast<double>(scale2);
+}
+
+
+#ifdef DEBUG
+// Whether x and y are at most kMaxUlps apart. The C library is taken to be
+// correctly rounded, so a kernel within the documented 1 ulp of the exact
+// result is at most 1 ulp away from it.
+static bool WithinUlps(double x, double y) {
+  static const int kMaxUlps = 1;
+  if (x == y) return true;
+  double larger = std::max(std::fabs(x), std::fabs(y));
+  double ulp = BitCast<double>(BitCast<uint64_t>(larger) + 1) - larger;
+  return std::fabs(x - y) <= kMaxUlps * ulp;
+}
+
+
+void BatchMathExtension::VerifyKernels() {
+  static const double kPio2 = 1.57079632679489655800e+00;
+  // Multiples of pi/2 across the reducible range and an argument close to
+  // one that lost most of its bits in an earlier, single pass reduction.
+  static const double kMultiples[] = { 1, 2, 3, 4, 5, 100, 1000, 12345,
+                                       204551, 524287 };
+  for (size_t i = 0; i < ARRAY_SIZE(kMultiples); i++) {
+    double x = kMultiples[i] * kPio2;
+    for (int j = -2; j <= 2; j++) {
+      double y = BitCast<double>(BitCast<uint64_t>(x) + j);
+      CHECK(WithinUlps(FastSin(y), std::sin(y)));
+      CHECK(WithinUlps(FastCos(y), std::cos(y)));
+      CHECK(WithinUlps(FastSin(-y), std::sin(-y)));
+      CHECK(WithinUlps(FastCos(-y), std::cos(-y)));
+    }
+  }
+  CHECK(WithinUlps(FastCos(321307.9594422229), std::cos(321307.9594422229)));
+}
+#endif
+
+
+struct SinKernelOp {
+  static double Apply(double x) { return FastSin(x); }
+};
+
+
+struct CosKernelOp {
+  static double Apply(double x) { return FastCos(x); }
+};
+
+
+struct ExpKernelOp {
+  static double Apply(double x) { return FastExp(x); }
+};
+
+
+struct SqrtKernelOp {
+  static double Apply(double x) { return std::sqrt(x); }
+};
+
+
+template <typename Src, typename Dst, typename Kernel>
+static void ApplyKernel(const Src* src, Dst* dst, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    dst[i] = static_cast<Dst>(Kernel::Apply(static_cast<double>(src[i])));
+  }
+}
+
+
+static void* TypedArrayData(v8::Handle<v8::TypedArray> array) {
+  Handle<JSArrayBuffer> buffer = Utils::OpenHandle(*array->Buffer());
+  return static_cast<uint8_t*>(buffer->backing_store()) + array->ByteOffset();
+}
+
+
+template <typename Kernel>
+static void ApplyToTypedArray(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  v8::Isolate* isolate = args.GetIsolate();
+  v8::Handle<v8::Value> src_value = args[0];
+  v8::Handle<v8::Value> dst_value = args.Length() > 1 ? args[1] : args[0];
+  if (!(src_value->IsFloat32Array() || src_value->IsFloat64Array()) ||
+      !(dst_value->IsFloat32Array() || dst_value->IsFloat64Array())) {
+    isolate->ThrowException(v8::Exception::TypeError(v8::String::NewFromUtf8(
+        isolate, "Expected Float32Array or Float64Array arguments.")));
+    return;
+  }
+  v8::Handle<v8::TypedArray> src = src_value.As<v8::TypedArray>();
+  v8::Handle<v8::TypedArray> dst = dst_value.As<v8::TypedArray>();
+  size_t length = src->Length();
+  if (dst->Length() != length) {
+    isolate->ThrowException(v8::Exception::RangeError(v8::String::NewFromUtf8(
+        isolate, "Source and destination lengths differ.")));
+    return;
+  }
+
+  void* src_data = TypedArrayData(src);
+  void* dst_data = TypedArrayData(dst);
+  // The kernels read each element once and then write it, so only a view
+  // onto exactly the same elements can be updated in place. Any other
+  // overlap would overwrite elements before they are read, so the source is
+  // copied first.
+  size_t src_bytes = src->ByteLength();
+  uint8_t* src_start = static_cast<uint8_t*>(src_data);
+  uint8_t* dst_start = static_cast<uint8_t*>(dst_data);
+  bool overlap = src_start < dst_start + dst->ByteLength() &&
+                 dst_start < src_start + src_bytes;
+  bool same_view = src_data == dst_data &&
+                   src->IsFloat64Array() == dst->IsFloat64Array();
+  ScopedVector<double> copy(
+      overlap && !same_view
+          ? static_cast<int>(RoundUp(src_bytes, sizeof(double)) /
+                             sizeof(double))
+          : 0);
+  if (copy.length() > 0) {
+    OS::MemCopy(copy.start(), src_data, src_bytes);
+    src_data = copy.start();
+  }
+
+  if (src->IsFloat64Array()) {
+    if (dst->IsFloat64Array()) {
+      ApplyKernel<double, double, Kernel>(
+          static_cast<double*>(src_data), static_cast<double*>(dst_data),
+          length);
+    } else {
+      ApplyKernel<double, float, Kernel>(
+          static_cast<double*>(src_data), static_cast<float*>(dst_data),
+          length);
+    }
+  } else {
+    if (dst->IsFloat64Array()) {
+      ApplyKernel<float, double, Kernel>(
+          static_cast<float*>(src_data), static_cast<double*>(dst_data),
+          length);
+    } else {
+      ApplyKernel<float, float, Kernel>(
+          static_cast<float*>(src_data), static_cast<float*>(dst_data),
+          length);
+    }
+  }
+  args.GetReturnValue().Set(dst);
+}
+
+
+void BatchMathExtension::SinArray(
+    const v8::FunctionCallbackInfo<v8::Value>& args) {
+  ApplyToTypedArray<SinKernelOp>(args);
+}
+
+
+void BatchMathExtension::CosArray(
+    const v8::FunctionCallbackInfo<v8::Value>& args) {
+  ApplyToTypedArray<CosKernelOp>(args);
+}
+
+
+void BatchMathExtension::ExpArray(
+    const v8::FunctionCallbackInfo<v8::Value>& args) {
+  ApplyToTypedArray<ExpKernelOp>(args);
+}
+
+
+void BatchMathExtension::SqrtArray(
+    const v8::FunctionCallbackInfo<v8::Value>& args) {
+  ApplyToTypedArray<SqrtKernelOp>(args);
+}
+
+} }  // namespace v8::internal
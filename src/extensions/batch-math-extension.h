@@ -0,0 +1,45 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_EXTENSIONS_BATCH_MATH_EXTENSION_H_
+#define V8_EXTENSIONS_BATCH_MATH_EXTENSION_H_
+
+#include "v8.h"
+
+namespace v8 {
+namespace internal {
+
+// Installs Math.sinArray, Math.cosArray, Math.expArray and Math.sqrtArray.
+// Each takes a source Float32Array or Float64Array and an optional
+// destination typed array of the same length (defaulting to the source),
+// and applies the function to every element. The source and destination
+// may share a buffer and overlap in any way.
+class BatchMathExtension : public v8::Extension {
+ public:
+  BatchMathExtension() : v8::Extension("v8/batch-math", kSource) {
+#ifdef DEBUG
+    VerifyKernels();
+#endif
+  }
+  virtual v8::Handle<v8::FunctionTemplate> GetNativeFunctionTemplate(
+      v8::Isolate* isolate,
+      v8::Handle<v8::String> name);
+  static void SinArray(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void CosArray(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void ExpArray(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SqrtArray(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+ private:
+  static const char* const kSource;
+
+#ifdef DEBUG
+  // Checks the kernels against the C library at arguments where the argument
+  // reduction is hardest.
+  static void VerifyKernels();
+#endif
+};
+
+} }  // namespace v8::internal
+
+#endif  // V8_EXTENSIONS_BATCH_MATH_EXTENSION_H_
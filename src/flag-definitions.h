@@ -362,6 +362,12 @@ DEFINE_int(typed_array_max_size_in_heap, 64,
 
 // Profiler flags.
 DEFINE_int(frame_count, 1, "number of stack frames inspected by the profiler")
+DEFINE_string(startup_profile, NULL,
+              "optimize the functions listed in this file as soon as their "
+              "type feedback is stable")
+DEFINE_string(startup_profile_out, NULL,
+              "write the functions optimized by the profiler in any isolate "
+              "to this file when V8 is disposed")
            // 0x1800 fits in the immediate field of an ARM instruction.
 DEFINE_int(interrupt_budget, 0x1800,
            "execution budget before interrupt is triggered")
@@ -409,6 +415,11 @@ DEFINE_bool(force_long_branches, false,
 // bootstrapper.cc
 DEFINE_string(expose_natives_as, NULL, "expose natives in global object")
 DEFINE_string(expose_debug_as, NULL, "expose debug in global object")
+DEFINE_bool(lazy_experimental_natives, true,
+            "compile experimental natives that only define globals on first "
+            "access to those globals")
+DEFINE_bool(expose_batch_math, false,
+            "expose Math.sinArray, cosArray, expArray and sqrtArray")
 DEFINE_bool(expose_free_buffer, false, "expose freeBuffer extension")
 DEFINE_bool(expose_gc, false, "expose gc extension")
 DEFINE_string(expose_gc_as, NULL,
@@ -492,6 +503,18 @@ DEFINE_bool(always_inline_smi_code, false,
 DEFINE_int(max_new_space_size, 0, "max size of the new generation (in kBytes)")
 DEFINE_int(max_old_space_size, 0, "max size of the old generation (in Mbytes)")
 DEFINE_int(max_executable_size, 0, "max size of executable memory (in Mbytes)")
+DEFINE_int(max_store_buffer_entries, 0,
+           "max number of slots in the old store buffer "
+           "(0: derive from the max size of the old generation)")
+DEFINE_bool(store_buffer_card_marking, true,
+            "track stores into popular large arrays in card tables instead "
+            "of scanning the whole array on scavenge")
+DEFINE_int(large_object_headroom, 100,
+           "address space reserved behind large objects for growing them in "
+           "place (in percent of the object size)")
+DEFINE_int(retained_large_object_space, 32,
+           "max size of freed large object pages kept for reuse until the "
+           "next full GC (in Mbytes)")
 DEFINE_bool(gc_global, false, "always perform global GCs")
 DEFINE_int(gc_interval, -1, "garbage collect after <n> allocations")
 DEFINE_bool(trace_gc, false,
@@ -819,6 +842,9 @@ DEFINE_bool(log_timer_events, false,
             "Time events including external callbacks.")
 DEFINE_implication(log_timer_events, log_internal_timer_events)
 DEFINE_implication(log_internal_timer_events, prof)
+DEFINE_bool(time_stamp_counter, false,
+            "use the invariant CPU time stamp counter as the high resolution "
+            "clock (x64 Linux only)")
 DEFINE_bool(log_instruction_stats, false, "Log AArch64 instruction statistics.")
 DEFINE_string(log_instruction_file, "arm64_inst.csv",
               "AArch64 instruction statistics log file.")
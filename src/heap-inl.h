@@ -288,13 +288,19 @@ MaybeObject* Heap::NumberFromUint32(
 }
 
 
-void Heap::FinalizeExternalString(String* string) {
+v8::String::ExternalStringResourceBase** Heap::ExternalStringResourceSlot(
+    String* string) {
   ASSERT(string->IsExternalString());
+  return reinterpret_cast<v8::String::ExternalStringResourceBase**>(
+      reinterpret_cast<byte*>(string) +
+      ExternalString::kResourceOffset -
+      kHeapObjectTag);
+}
+
+
+void Heap::FinalizeExternalString(String* string) {
   v8::String::ExternalStringResourceBase** resource_addr =
-      reinterpret_cast<v8::String::ExternalStringResourceBase**>(
-          reinterpret_cast<byte*>(string) +
-          ExternalString::kResourceOffset -
-          kHeapObjectTag);
+      ExternalStringResourceSlot(string);
 
   // Dispose of the C++ object if it has not already been disposed.
   if (*resource_addr != NULL) {
@@ -689,6 +695,20 @@ void ExternalStringTable::AddString(String* string) {
 }
 
 
+void ExternalStringTable::QueueForDisposal(String* string) {
+  v8::String::ExternalStringResourceBase** resource_addr =
+      Heap::ExternalStringResourceSlot(string);
+
+  if (*resource_addr != NULL) {
+    queued_resources_.Add(*resource_addr);
+    queued_resource_bytes_ += string->IsOneByteRepresentation()
+        ? string->length()
+        : string->length() * kUC16Size;
+    *resource_addr = NULL;
+  }
+}
+
+
 void ExternalStringTable::Iterate(ObjectVisitor* v) {
   if (!new_space_strings_.is_empty()) {
     Object** start = &new_space_strings_[0];
@@ -769,6 +769,7 @@ void Heap::CollectAllAvailableGarbage(const char* gc_reason) {
     }
   }
   mark_compact_collector()->SetFlags(kNoGCFlags);
+  DisposeQueuedExternalStringResources();
   new_space_.Shrink();
   UncommitFromSpace();
   incremental_marking()->UncommitMarkingDeque();
@@ -856,6 +857,12 @@ bool Heap::CollectGarbage(GarbageCollector collector,
     GarbageCollectionEpilogue();
   }
 
+  // Resources of dead external strings are normally released from idle
+  // notifications. Do not let them pile up if the embedder sends none.
+  if (external_string_table_.ShouldDisposeQueuedResources()) {
+    DisposeQueuedExternalStringResources();
+  }
+
   // Start incremental marking for the next cycle. The heap snapshot
   // generator needs incremental marking to stay off after it aborted.
   if (!mark_compact_collector()->abort_incremental_marking() &&
@@ -1659,7 +1666,7 @@ String* Heap::UpdateNewSpaceReferenceInExternalStringTableEntry(Heap* heap,
 
   if (!first_word.IsForwardingAddress()) {
     // Unreachable external string can be finalized.
-    heap->FinalizeExternalString(String::cast(*p));
+    heap->external_string_table()->QueueForDisposal(String::cast(*p));
     return NULL;
   }
 
@@ -3315,14 +3322,7 @@ bool Heap::CreateInitialObjects() {
   }
   set_observation_state(JSObject::cast(obj));
 
-  // Allocate object to hold object microtask state.
-  { MaybeObject* maybe_obj = AllocateMap(JS_OBJECT_TYPE, JSObject::kHeaderSize);
-    if (!maybe_obj->ToObject(&obj)) return false;
-  }
-  { MaybeObject* maybe_obj = AllocateJSObjectFromMap(Map::cast(obj));
-    if (!maybe_obj->ToObject(&obj)) return false;
-  }
-  set_microtask_state(JSObject::cast(obj));
+  set_microtask_queue(empty_fixed_array());
 
   { MaybeObject* maybe_obj = AllocateSymbol();
     if (!maybe_obj->ToObject(&obj)) return false;
@@ -3415,6 +3415,7 @@ bool Heap::RootCanBeWrittenAfterInitialization(Heap::RootListIndex root_index) {
     kGetterStubDeoptPCOffsetRootIndex,
     kSetterStubDeoptPCOffsetRootIndex,
     kStringTableRootIndex,
+    kMicrotaskQueueRootIndex,
   };
 
   for (unsigned int i = 0; i < ARRAY_SIZE(writable_roots); i++) {
@@ -5561,6 +5562,8 @@ void Heap::AdvanceIdleIncrementalMarking(intptr_t step_size) {
 
 
 bool Heap::IdleNotification(int hint) {
+  DisposeQueuedExternalStringResources();
+
   // Hints greater than this value indicate that
   // the embedder is requesting a lot of GC work.
   const int kMaxHint = 1000;
@@ -6607,6 +6610,7 @@ void Heap::TearDown() {
 
   isolate_->global_handles()->TearDown();
 
+  DisposeQueuedExternalStringResources();
   external_string_table_.TearDown();
 
   mark_compact_collector()->TearDown();
@@ -7416,6 +7420,8 @@ GCTracer::~GCTracer() {
         scopes_[Scope::MC_WEAKCOLLECTION_PROCESS]);
     PrintF("weakcollection_clear=%.1f ",
         scopes_[Scope::MC_WEAKCOLLECTION_CLEAR]);
+    PrintF("external_strings=%.1f ",
+        scopes_[Scope::MC_EXTERNAL_STRING_TABLE]);
 
     PrintF("total_size_before=%" V8_PTR_PREFIX "d ", start_object_size_);
     PrintF("total_size_after=%" V8_PTR_PREFIX "d ", heap_->SizeOfObjects());
@@ -7556,6 +7562,8 @@ void ExternalStringTable::CleanUp() {
   }
   old_space_strings_.Rewind(last);
   old_space_strings_.Trim();
+  heap_->isolate()->counters()->external_string_table_entries()->Set(
+      new_space_strings_.length() + old_space_strings_.length());
 #ifdef VERIFY_HEAP
   if (FLAG_verify_heap) {
     Verify();
@@ -7564,7 +7572,27 @@ void ExternalStringTable::CleanUp() {
 }
 
 
+void Heap::DisposeQueuedExternalStringResources() {
+  List<v8::String::ExternalStringResourceBase*>* queued =
+      &external_string_table_.queued_resources_;
+  if (queued->is_empty()) return;
+  // Take the list first in case a Dispose() callback ends up triggering
+  // another GC that queues more resources.
+  List<v8::String::ExternalStringResourceBase*> resources;
+  resources.AddAll(*queued);
+  queued->Clear();
+  external_string_table_.queued_resource_bytes_ = 0;
+  for (int i = 0; i < resources.length(); ++i) {
+    resources[i]->Dispose();
+  }
+  isolate_->counters()->external_string_resources_disposed()->Increment(
+      resources.length());
+}
+
+
 void ExternalStringTable::TearDown() {
+  ASSERT(queued_resources_.is_empty());
+  queued_resources_.Free();
   for (int i = 0; i < new_space_strings_.length(); ++i) {
     heap_->FinalizeExternalString(ExternalString::cast(new_space_strings_[i]));
   }
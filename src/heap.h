@@ -216,7 +216,7 @@ namespace internal {
   V(Symbol, megamorphic_symbol, MegamorphicSymbol)                             \
   V(FixedArray, materialized_objects, MaterializedObjects)                     \
   V(FixedArray, allocation_sites_scratchpad, AllocationSitesScratchpad)        \
-  V(JSObject, microtask_state, MicrotaskState)
+  V(FixedArray, microtask_queue, MicrotaskQueue)
 
 // Entries in this list are limited to Smis and are not visited during GC.
 #define SMI_ROOT_LIST(V)                                                       \
@@ -383,7 +383,13 @@ namespace internal {
   V(byte_offset_string, "byteOffset")                                    \
   V(buffer_string, "buffer")                                             \
   V(intl_initialized_marker_string, "v8::intl_initialized_marker")       \
-  V(intl_impl_object_string, "v8::intl_object")
+  V(intl_impl_object_string, "v8::intl_object")                          \
+  V(add_string, "add")                                                   \
+  V(update_string, "update")                                             \
+  V(delete_string, "delete")                                             \
+  V(reconfigure_string, "reconfigure")                                   \
+  V(setPrototype_string, "setPrototype")                                 \
+  V(preventExtensions_string, "preventExtensions")
 
 // Forward declarations.
 class GCTracer;
@@ -532,11 +538,26 @@ class ExternalStringTable {
   // Must be called after each Iterate() that modified the strings.
   void CleanUp();
 
+  // Detaches the resource of a dead external string and queues it for
+  // disposal once the current GC pause is over.
+  inline void QueueForDisposal(String* string);
+
+  // Returns whether enough resources are queued that they should be
+  // disposed right after the GC instead of waiting for idle time.
+  bool ShouldDisposeQueuedResources() const {
+    return queued_resources_.length() >= kMaxQueuedResources ||
+           queued_resource_bytes_ >= kMaxQueuedResourceBytes;
+  }
+
   // Destroys all allocated memory.
   void TearDown();
 
  private:
-  explicit ExternalStringTable(Heap* heap) : heap_(heap) { }
+  explicit ExternalStringTable(Heap* heap)
+      : queued_resource_bytes_(0), heap_(heap) { }
+
+  static const int kMaxQueuedResources = 1024;
+  static const intptr_t kMaxQueuedResourceBytes = 4 * MB;
 
   friend class Heap;
 
@@ -552,6 +573,14 @@ class ExternalStringTable {
   List<Object*> new_space_strings_;
   List<Object*> old_space_strings_;
 
+  // Resources of strings that died in past GCs. Dispose() can run arbitrary
+  // embedder code, so it is called from idle notifications, or right after
+  // a GC once too much has been queued, instead of while the table is being
+  // processed.
+  List<v8::String::ExternalStringResourceBase*> queued_resources_;
+  // Character bytes held by the queued resources.
+  intptr_t queued_resource_bytes_;
+
   Heap* heap_;
 
   DISALLOW_COPY_AND_ASSIGN(ExternalStringTable);
@@ -1129,6 +1158,14 @@ class Heap {
   // data and clearing the resource pointer.
   inline void FinalizeExternalString(String* string);
 
+  // Returns the address of the resource pointer of an external string.
+  static inline v8::String::ExternalStringResourceBase**
+      ExternalStringResourceSlot(String* string);
+
+  // Disposes the resources of external strings that died in past GCs.
+  // Must not be called during a GC pause.
+  void DisposeQueuedExternalStringResources();
+
   // Allocates an uninitialized object.  The memory is non-executable if the
   // hardware and OS allow.
   // Returns Failure::RetryAfterGC(requested_bytes, space) if the allocation
@@ -2831,6 +2868,7 @@ class GCTracer BASE_EMBEDDED {
       MC_UPDATE_MISC_POINTERS,
       MC_WEAKCOLLECTION_PROCESS,
       MC_WEAKCOLLECTION_CLEAR,
+      MC_EXTERNAL_STRING_TABLE,
       MC_FLUSH_CODE,
       kNumberOfScopes
     };
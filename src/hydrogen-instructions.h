@@ -6059,6 +6059,10 @@ class HObjectAccess V8_FINAL {
         JSArrayBufferView::kByteLengthOffset);
   }
 
+  static HObjectAccess ForJSCollectionTable() {
+    return HObjectAccess::ForObservableJSObjectOffset(JSMap::kTableOffset);
+  }
+
   static HObjectAccess ForGlobalObjectNativeContext() {
     return HObjectAccess(kInobject, GlobalObject::kNativeContextOffset);
   }
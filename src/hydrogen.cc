@@ -1503,10 +1503,10 @@ HValue* HGraphBuilder::BuildUncheckedDictionaryElementLoadHelper(
 }
 
 
-HValue* HGraphBuilder::BuildElementIndexHash(HValue* index) {
-  int32_t seed_value = static_cast<uint32_t>(isolate()->heap()->HashSeed());
+// Mirrors ComputeIntegerHash.
+HValue* HGraphBuilder::BuildIntegerHash(HValue* value, int32_t seed_value) {
   HValue* seed = Add<HConstant>(seed_value);
-  HValue* hash = AddUncasted<HBitwise>(Token::BIT_XOR, index, seed);
+  HValue* hash = AddUncasted<HBitwise>(Token::BIT_XOR, value, seed);
 
   // hash = ~hash + (hash << 15);
   HValue* shifted_hash = AddUncasted<HShl>(hash, Add<HConstant>(15));
@@ -1536,6 +1536,12 @@ HValue* HGraphBuilder::BuildElementIndexHash(HValue* index) {
 }
 
 
+HValue* HGraphBuilder::BuildElementIndexHash(HValue* index) {
+  int32_t seed_value = static_cast<uint32_t>(isolate()->heap()->HashSeed());
+  return BuildIntegerHash(index, seed_value);
+}
+
+
 HValue* HGraphBuilder::BuildUncheckedDictionaryElementLoad(HValue* receiver,
                                                            HValue* key) {
   HValue* elements = AddLoadElements(receiver);
@@ -8784,6 +8790,267 @@ void HOptimizedGraphBuilder::GenerateTypedArrayGetLength(
 }
 
 
+// Walks the bucket chain of an OrderedHashTable starting at |entry|, for at
+// most kOrderedHashTableProbes entries. Returns the table index of the key,
+// OrderedHashMap::kNotFound at the end of the chain, or kLookupInRuntime
+// when the probes run out.
+HValue* HOptimizedGraphBuilder::BuildOrderedHashTableProbe(
+    HValue* table,
+    HValue* key,
+    HValue* data_start,
+    HValue* entry,
+    int entry_size,
+    int current_probe) {
+  if (current_probe == kOrderedHashTableProbes) {
+    return Add<HConstant>(kLookupInRuntime);
+  }
+
+  IfBuilder if_chain_end(this);
+  if_chain_end.If<HCompareNumericAndBranch>(
+      entry, Add<HConstant>(OrderedHashMap::kNotFound), Token::EQ);
+  if_chain_end.Then();
+  {
+    Push(Add<HConstant>(OrderedHashMap::kNotFound));
+  }
+  if_chain_end.Else();
+  {
+    HValue* key_index = AddUncasted<HMul>(entry, Add<HConstant>(entry_size));
+    key_index->ClearFlag(HValue::kCanOverflow);
+    key_index = AddUncasted<HAdd>(key_index, data_start);
+    key_index->ClearFlag(HValue::kCanOverflow);
+
+    HValue* candidate_key = Add<HLoadKeyed>(table, key_index,
+                                            static_cast<HValue*>(NULL),
+                                            FAST_ELEMENTS);
+    IfBuilder if_match(this);
+    if_match.If<HCompareObjectEqAndBranch>(key, candidate_key);
+    if_match.Then();
+    {
+      Push(key_index);
+    }
+    if_match.Else();
+    {
+      // Long string keys are stored as they are unless an internalized copy
+      // existed, so a string key can equal a candidate that is not the same
+      // object.
+      IfBuilder if_smi(this);
+      if_smi.If<HIsSmiAndBranch>(candidate_key);
+      if_smi.Then();
+      {
+        Push(Add<HConstant>(static_cast<int32_t>(kIsNotStringMask)));
+      }
+      if_smi.Else();
+      {
+        HValue* map = Add<HLoadNamedField>(candidate_key,
+                                           static_cast<HValue*>(NULL),
+                                           HObjectAccess::ForMap());
+        HValue* instance_type = Add<HLoadNamedField>(
+            map, static_cast<HValue*>(NULL),
+            HObjectAccess::ForMapInstanceType());
+        Push(AddUncasted<HBitwise>(
+            Token::BIT_AND, instance_type,
+            Add<HConstant>(static_cast<int32_t>(
+                kIsNotStringMask | kIsNotInternalizedMask))));
+      }
+      if_smi.End();
+      HValue* string_bits = Pop();
+
+      IfBuilder if_string(this);
+      if_string.If<HCompareNumericAndBranch>(
+          string_bits,
+          Add<HConstant>(static_cast<int32_t>(
+              kStringTag | kNotInternalizedTag)),
+          Token::EQ);
+      if_string.Then();
+      {
+        Push(Add<HConstant>(kLookupInRuntime));
+      }
+      if_string.Else();
+      {
+        // The chain link follows the key and, for maps, the value.
+        HValue* chain_index = AddUncasted<HAdd>(
+            key_index, Add<HConstant>(entry_size - 1));
+        chain_index->ClearFlag(HValue::kCanOverflow);
+        HValue* next_entry = Add<HLoadKeyed>(table, chain_index,
+                                             static_cast<HValue*>(NULL),
+                                             FAST_SMI_ELEMENTS);
+        Push(BuildOrderedHashTableProbe(table, key, data_start, next_entry,
+                                        entry_size, current_probe + 1));
+      }
+      if_string.End();
+    }
+    if_match.End();
+  }
+  if_chain_end.End();
+
+  return Pop();
+}
+
+
+// Looks up |key| in the OrderedHashTable of a JSMap or JSSet. The runtime
+// stores Smi-valued numbers as Smis and short strings internalized, so Smi
+// and internalized string keys are found by pointer comparison. Other keys,
+// chains that hold a string that is not internalized, and chains longer
+// than kOrderedHashTableProbes call the runtime function.
+HValue* HOptimizedGraphBuilder::BuildJSCollectionLookup(CallRuntime* call,
+                                                        HValue* receiver,
+                                                        HValue* key,
+                                                        int entry_size,
+                                                        bool load_value) {
+  STATIC_ASSERT(JSMap::kTableOffset == JSSet::kTableOffset);
+  STATIC_ASSERT(static_cast<int>(OrderedHashSet::kHashTableStartIndex) ==
+                static_cast<int>(OrderedHashMap::kHashTableStartIndex));
+  NoObservableSideEffectsScope scope(this);
+
+  HValue* table = Add<HLoadNamedField>(receiver, static_cast<HValue*>(NULL),
+                                       HObjectAccess::ForJSCollectionTable());
+
+  // Compute the hash like Object::GetHash.
+  HIfContinuation has_hash(graph()->CreateBasicBlock(),
+                           graph()->CreateBasicBlock());
+  IfBuilder if_smi(this);
+  if_smi.If<HIsSmiAndBranch>(key);
+  if_smi.Then();
+  {
+    // GetHash also masks with Smi::kMaxValue, which keeps the bucket bits.
+    Push(BuildIntegerHash(key, kZeroHashSeed));
+  }
+  if_smi.Else();
+  {
+    HValue* map = Add<HLoadNamedField>(key, static_cast<HValue*>(NULL),
+                                       HObjectAccess::ForMap());
+    HValue* instance_type = Add<HLoadNamedField>(
+        map, static_cast<HValue*>(NULL), HObjectAccess::ForMapInstanceType());
+    HValue* string_bits = AddUncasted<HBitwise>(
+        Token::BIT_AND, instance_type,
+        Add<HConstant>(static_cast<int32_t>(
+            kIsNotStringMask | kIsNotInternalizedMask)));
+
+    IfBuilder if_internalized(this);
+    if_internalized.If<HCompareNumericAndBranch>(
+        string_bits,
+        Add<HConstant>(static_cast<int32_t>(kStringTag | kInternalizedTag)),
+        Token::EQ);
+    if_internalized.Then();
+    {
+      // Internalized strings always have their hash computed.
+      HValue* hash_field = Add<HLoadNamedField>(
+          key, static_cast<HValue*>(NULL), HObjectAccess::ForStringHashField());
+      Push(AddUncasted<HShr>(hash_field, Add<HConstant>(Name::kHashShift)));
+    }
+    if_internalized.JoinContinuation(&has_hash);
+  }
+  if_smi.JoinContinuation(&has_hash);
+
+  IfBuilder if_has_hash(this, &has_hash);
+  if_has_hash.Then();
+  {
+    HValue* hash = Pop();
+    HValue* buckets = Add<HLoadKeyed>(
+        table, Add<HConstant>(OrderedHashMap::kNumberOfBucketsIndex),
+        static_cast<HValue*>(NULL), FAST_SMI_ELEMENTS);
+    HValue* mask = AddUncasted<HSub>(buckets, graph()->GetConstant1());
+    mask->ChangeRepresentation(Representation::Integer32());
+    mask->ClearFlag(HValue::kCanOverflow);
+
+    HValue* bucket = AddUncasted<HBitwise>(Token::BIT_AND, hash, mask);
+    HValue* bucket_index = AddUncasted<HAdd>(
+        bucket, Add<HConstant>(OrderedHashMap::kHashTableStartIndex));
+    bucket_index->ClearFlag(HValue::kCanOverflow);
+    HValue* entry = Add<HLoadKeyed>(table, bucket_index,
+                                    static_cast<HValue*>(NULL),
+                                    FAST_SMI_ELEMENTS);
+
+    HValue* data_start = AddUncasted<HAdd>(
+        buckets, Add<HConstant>(OrderedHashMap::kHashTableStartIndex));
+    data_start->ClearFlag(HValue::kCanOverflow);
+
+    Push(BuildOrderedHashTableProbe(table, key, data_start, entry,
+                                    entry_size, 0));
+  }
+  if_has_hash.Else();
+  {
+    Push(Add<HConstant>(kLookupInRuntime));
+  }
+  if_has_hash.End();
+  HValue* key_index = Pop();
+
+  IfBuilder if_runtime(this);
+  if_runtime.If<HCompareNumericAndBranch>(
+      key_index, Add<HConstant>(kLookupInRuntime), Token::EQ);
+  if_runtime.Then();
+  {
+    Add<HPushArgument>(receiver);
+    Add<HPushArgument>(key);
+    Push(Add<HCallRuntime>(call->name(), call->function(), 2));
+  }
+  if_runtime.Else();
+  {
+    IfBuilder if_found(this);
+    if_found.If<HCompareNumericAndBranch>(
+        key_index, Add<HConstant>(OrderedHashMap::kNotFound), Token::NE);
+    if_found.Then();
+    {
+      if (load_value) {
+        HValue* value_index = AddUncasted<HAdd>(
+            key_index, Add<HConstant>(OrderedHashMap::kValueOffset));
+        value_index->ClearFlag(HValue::kCanOverflow);
+        Push(Add<HLoadKeyed>(table, value_index,
+                             static_cast<HValue*>(NULL),
+                             FAST_ELEMENTS));
+      } else {
+        Push(graph()->GetConstantTrue());
+      }
+    }
+    if_found.Else();
+    {
+      Push(load_value ? graph()->GetConstantUndefined()
+                      : graph()->GetConstantFalse());
+    }
+    if_found.End();
+  }
+  if_runtime.End();
+
+  return Pop();
+}
+
+
+void HOptimizedGraphBuilder::GenerateSetHas(CallRuntime* call) {
+  ASSERT(call->arguments()->length() == 2);
+  CHECK_ALIVE(VisitForValue(call->arguments()->at(0)));
+  CHECK_ALIVE(VisitForValue(call->arguments()->at(1)));
+  HValue* key = Pop();
+  HValue* set = Pop();
+  HValue* result = BuildJSCollectionLookup(
+      call, set, key, OrderedHashSet::kEntrySize, false);
+  return ast_context()->ReturnValue(result);
+}
+
+
+void HOptimizedGraphBuilder::GenerateMapHas(CallRuntime* call) {
+  ASSERT(call->arguments()->length() == 2);
+  CHECK_ALIVE(VisitForValue(call->arguments()->at(0)));
+  CHECK_ALIVE(VisitForValue(call->arguments()->at(1)));
+  HValue* key = Pop();
+  HValue* map = Pop();
+  HValue* result = BuildJSCollectionLookup(
+      call, map, key, OrderedHashMap::kEntrySize, false);
+  return ast_context()->ReturnValue(result);
+}
+
+
+void HOptimizedGraphBuilder::GenerateMapGet(CallRuntime* call) {
+  ASSERT(call->arguments()->length() == 2);
+  CHECK_ALIVE(VisitForValue(call->arguments()->at(0)));
+  CHECK_ALIVE(VisitForValue(call->arguments()->at(1)));
+  HValue* key = Pop();
+  HValue* map = Pop();
+  HValue* result = BuildJSCollectionLookup(
+      call, map, key, OrderedHashMap::kEntrySize, true);
+  return ast_context()->ReturnValue(result);
+}
+
+
 void HOptimizedGraphBuilder::VisitCallRuntime(CallRuntime* expr) {
   ASSERT(!HasStackOverflow());
   ASSERT(current_block() != NULL);
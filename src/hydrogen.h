@@ -1791,6 +1791,7 @@ class HGraphBuilder {
                                  ElementsKind kind,
                                  int length);
 
+  HValue* BuildIntegerHash(HValue* value, int32_t seed);
   HValue* BuildElementIndexHash(HValue* index);
 
   void BuildCompareNil(
@@ -2093,6 +2094,11 @@ class HOptimizedGraphBuilder : public HGraphBuilder, public AstVisitor {
   static const int kMaxFastLiteralDepth = 3;
   static const int kMaxFastLiteralProperties = 8;
 
+  // Number of chain entries Map and Set lookups probe inline before calling
+  // the runtime, and the probe result that asks for that call.
+  static const int kOrderedHashTableProbes = 4;
+  static const int kLookupInRuntime = -2;
+
   // Simple accessors.
   void set_function_state(FunctionState* state) { function_state_ = state; }
 
@@ -2335,6 +2341,18 @@ class HOptimizedGraphBuilder : public HGraphBuilder, public AstVisitor {
       ElementsKind fixed_elements_kind,
       HValue* byte_length, HValue* length);
 
+  HValue* BuildOrderedHashTableProbe(HValue* table,
+                                     HValue* key,
+                                     HValue* data_start,
+                                     HValue* entry,
+                                     int entry_size,
+                                     int current_probe);
+  HValue* BuildJSCollectionLookup(CallRuntime* call,
+                                  HValue* receiver,
+                                  HValue* key,
+                                  int entry_size,
+                                  bool load_value);
+
   bool IsCallNewArrayInlineable(CallNew* expr);
   void BuildInlinedCallNewArray(CallNew* expr);
 
@@ -28,6 +28,8 @@
 
 #include "i18n.h"
 
+#include "char-predicates-inl.h"
+
 #include "unicode/brkiter.h"
 #include "unicode/calendar.h"
 #include "unicode/coll.h"
@@ -45,7 +47,9 @@
 #include "unicode/uchar.h"
 #include "unicode/ucol.h"
 #include "unicode/ucurr.h"
+#include "unicode/uniset.h"
 #include "unicode/unum.h"
+#include "unicode/usetiter.h"
 #include "unicode/uversion.h"
 
 namespace v8 {
@@ -794,6 +798,17 @@ void SetResolvedBreakIteratorSettings(Isolate* isolate,
   }
 }
 
+
+bool IsAsciiAlphanumeric(Vector<const uint8_t> chars) {
+  for (int i = 0; i < chars.length(); i++) {
+    uint8_t c = chars[i];
+    if (!IsDecimalDigit(c) && !IsInRange(AsciiAlphaToLower(c), 'a', 'z')) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace
 
 
@@ -991,6 +1006,124 @@ icu::Collator* Collator::UnpackCollator(Isolate* isolate,
 }
 
 
+Smi* Collator::ComputeAsciiCompareMode(icu::Collator* collator) {
+  UErrorCode status = U_ZERO_ERROR;
+  if (collator->getAttribute(UCOL_NUMERIC_COLLATION, status) != UCOL_OFF ||
+      U_FAILURE(status)) {
+    return Smi::FromInt(kAsciiCompareDisabled);
+  }
+
+  // Tailorings that touch ASCII letters or digits, including contractions
+  // such as Czech "ch", rule the fast path out.
+  icu::UnicodeSet ascii(UNICODE_STRING_SIMPLE("[0-9A-Za-z]"), status);
+  icu::UnicodeSet* tailored = collator->getTailoredSet(status);
+  if (U_FAILURE(status)) {
+    delete tailored;
+    return Smi::FromInt(kAsciiCompareDisabled);
+  }
+  bool is_tailored = false;
+  icu::UnicodeSetIterator it(*tailored);
+  while (!is_tailored && it.nextRange()) {
+    if (it.isString()) {
+      UChar32 first = it.getString().char32At(0);
+      is_tailored = ascii.contains(first);
+    } else {
+      is_tailored = ascii.containsSome(it.getCodepoint(),
+                                       it.getCodepointEnd());
+    }
+  }
+  delete tailored;
+  if (is_tailored) return Smi::FromInt(kAsciiCompareDisabled);
+
+  // Digits and letters must be ordered as in ASCII once case is ignored, and
+  // every letter must order against its uppercase form the same way.
+  static const char kAlphabet[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+  for (int i = 1; kAlphabet[i] != '\0'; i++) {
+    icu::UnicodeString previous(static_cast<UChar>(kAlphabet[i - 1]));
+    icu::UnicodeString current(static_cast<UChar>(kAlphabet[i]));
+    if (collator->compare(previous, current, status) != UCOL_LESS) {
+      return Smi::FromInt(kAsciiCompareDisabled);
+    }
+  }
+  UCollationResult case_order = UCOL_EQUAL;
+  for (char c = 'a'; c <= 'z'; c++) {
+    icu::UnicodeString lower(static_cast<UChar>(c));
+    icu::UnicodeString upper(static_cast<UChar>(c - 'a' + 'A'));
+    UCollationResult result = collator->compare(lower, upper, status);
+    if (c != 'a' && result != case_order) {
+      return Smi::FromInt(kAsciiCompareDisabled);
+    }
+    case_order = result;
+  }
+  if (U_FAILURE(status)) return Smi::FromInt(kAsciiCompareDisabled);
+
+  switch (case_order) {
+    case UCOL_LESS:
+      return Smi::FromInt(kAsciiCompareLowerFirst);
+    case UCOL_GREATER:
+      return Smi::FromInt(kAsciiCompareUpperFirst);
+    default:
+      return Smi::FromInt(kAsciiCompareIgnoreCase);
+  }
+}
+
+
+bool Collator::TryCompareAscii(Handle<JSObject> obj,
+                               Handle<String> string1,
+                               Handle<String> string2,
+                               int* result) {
+  int mode = Smi::cast(obj->GetInternalField(1))->value();
+  if (mode == kAsciiCompareDisabled) return false;
+
+  string1 = String::Flatten(string1);
+  string2 = String::Flatten(string2);
+  DisallowHeapAllocation no_allocation;
+  String::FlatContent flat1 = string1->GetFlatContent();
+  String::FlatContent flat2 = string2->GetFlatContent();
+  if (!flat1.IsAscii() || !flat2.IsAscii()) return false;
+  Vector<const uint8_t> chars1 = flat1.ToOneByteVector();
+  Vector<const uint8_t> chars2 = flat2.ToOneByteVector();
+  if (!IsAsciiAlphanumeric(chars1) || !IsAsciiAlphanumeric(chars2)) {
+    return false;
+  }
+
+  // Every character maps to a single collation element, so the first
+  // difference ignoring case decides, then the length, then the first
+  // difference in case.
+  int length = Min(chars1.length(), chars2.length());
+  int case_difference = 0;
+  for (int i = 0; i < length; i++) {
+    uint8_t c1 = chars1[i];
+    uint8_t c2 = chars2[i];
+    if (c1 == c2) continue;
+    uint8_t lower1 = c1 | 0x20;
+    uint8_t lower2 = c2 | 0x20;
+    if (lower1 != lower2) {
+      *result = lower1 < lower2 ? UCOL_LESS : UCOL_GREATER;
+      return true;
+    }
+    // Lowercase letters have the 0x20 bit set.
+    if (case_difference == 0) case_difference = (c1 & 0x20) ? -1 : 1;
+  }
+  if (chars1.length() != chars2.length()) {
+    *result = chars1.length() < chars2.length() ? UCOL_LESS : UCOL_GREATER;
+    return true;
+  }
+  switch (mode) {
+    case kAsciiCompareLowerFirst:
+      *result = case_difference;
+      break;
+    case kAsciiCompareUpperFirst:
+      *result = -case_difference;
+      break;
+    default:
+      *result = UCOL_EQUAL;
+      break;
+  }
+  return true;
+}
+
+
 void Collator::DeleteCollator(
     const v8::WeakCallbackData<v8::Value, void>& data) {
   DeleteNativeObjectAt<icu::Collator>(data, 0);
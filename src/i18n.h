@@ -116,12 +116,33 @@ class Collator {
   // Unpacks collator object from corresponding JavaScript object.
   static icu::Collator* UnpackCollator(Isolate* isolate, Handle<JSObject> obj);
 
+  // Determines whether strings made up only of ASCII letters and digits can
+  // be compared without ICU under the given collator. The result is stored
+  // next to the collator in the JavaScript object.
+  static Smi* ComputeAsciiCompareMode(icu::Collator* collator);
+
+  // Compares two strings without calling into ICU. Returns false if the
+  // collator does not allow it or either string contains a character other
+  // than an ASCII letter or digit.
+  static bool TryCompareAscii(Handle<JSObject> obj,
+                              Handle<String> string1,
+                              Handle<String> string2,
+                              int* result);
+
   // Release memory we allocated for the Collator once the JS object that holds
   // the pointer gets garbage collected.
   static void DeleteCollator(
       const v8::WeakCallbackData<v8::Value, void>& data);
 
  private:
+  // How ASCII letters that differ only in case compare under a collator.
+  enum AsciiCompareMode {
+    kAsciiCompareDisabled,
+    kAsciiCompareLowerFirst,
+    kAsciiCompareUpperFirst,
+    kAsciiCompareIgnoreCase
+  };
+
   Collator();
 };
 
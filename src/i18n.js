@@ -1941,17 +1941,54 @@ var defaultObjects = {
 };
 
 
+// Instances created for an explicit locale string and undefined options,
+// keyed by the locale string. Each service caches at most
+// MAX_CACHED_LOCALE_OBJECTS instances; further locales are not cached.
+var MAX_CACHED_LOCALE_OBJECTS = 16;
+
+var localeObjects = {
+  'collator': {},
+  'numberformat': {},
+  'dateformatall': {},
+  'dateformatdate': {},
+  'dateformattime': {},
+};
+
+var localeObjectsCount = {
+  'collator': 0,
+  'numberformat': 0,
+  'dateformatall': 0,
+  'dateformatdate': 0,
+  'dateformattime': 0,
+};
+
+
 /**
  * Returns cached or newly created instance of a given service.
- * We cache only default instances (where no locales or options are provided).
+ * We cache only instances created without options, either for the default
+ * locale or for a single locale given as a string. Reading the options would
+ * be observable, so instances created with options are never cached.
  */
 function cachedOrNewService(service, locales, options, defaults) {
   var useOptions = (defaults === undefined) ? options : defaults;
-  if (locales === undefined && options === undefined) {
-    if (defaultObjects[service] === undefined) {
-      defaultObjects[service] = new savedObjects[service](locales, useOptions);
+  if (options === undefined) {
+    if (locales === undefined) {
+      if (defaultObjects[service] === undefined) {
+        defaultObjects[service] =
+            new savedObjects[service](locales, useOptions);
+      }
+      return defaultObjects[service];
+    }
+    if (typeof locales === 'string') {
+      var cache = localeObjects[service];
+      if (%HasLocalProperty(cache, locales)) return cache[locales];
+      var object = new savedObjects[service](locales, useOptions);
+      if (localeObjectsCount[service] < MAX_CACHED_LOCALE_OBJECTS) {
+        cache[locales] = object;
+        localeObjectsCount[service]++;
+      }
+      return object;
     }
-    return defaultObjects[service];
   }
   return new savedObjects[service](locales, useOptions);
 }
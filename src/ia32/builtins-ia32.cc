@@ -1014,8 +1014,47 @@ void Builtins::Generate_FunctionApply(MacroAssembler* masm) {
     __ bind(&push_receiver);
     __ push(ebx);
 
-    // Copy all arguments from the array to the stack.
-    Label entry, loop;
+    // Copy all arguments from the array to the stack. Arrays and arguments
+    // objects with fast elements are copied straight from their backing store
+    // unless they contain holes, which need a lookup on the prototype chain.
+    Label entry, loop, slow_copy, check_elements_kind, copy_loop, copy_entry;
+    Label copy_hole, invoke;
+    __ mov(edx, Operand(ebp, kArgumentsOffset));
+    __ JumpIfSmi(edx, &slow_copy);
+    __ mov(eax, FieldOperand(edx, HeapObject::kMapOffset));
+    __ test_b(FieldOperand(eax, Map::kBitFieldOffset),
+              (1 << Map::kHasIndexedInterceptor) |
+              (1 << Map::kIsAccessCheckNeeded));
+    __ j(not_zero, &slow_copy);
+    __ CmpInstanceType(eax, JS_ARRAY_TYPE);
+    __ j(equal, &check_elements_kind, Label::kNear);
+    __ CmpInstanceType(eax, JS_OBJECT_TYPE);
+    __ j(not_equal, &slow_copy);
+    __ bind(&check_elements_kind);
+    __ CheckFastElements(eax, &slow_copy);
+    __ mov(ebx, FieldOperand(edx, JSObject::kElementsOffset));
+    __ mov(ecx, Operand(ebp, kLimitOffset));
+    __ cmp(ecx, FieldOperand(ebx, FixedArray::kLengthOffset));
+    __ j(greater, &slow_copy);
+    __ Move(eax, Immediate(0));
+    __ jmp(&copy_entry, Label::kNear);
+    __ bind(&copy_loop);
+    __ mov(edx, FieldOperand(ebx, eax, times_half_pointer_size,
+                             FixedArray::kHeaderSize));
+    __ cmp(edx, masm->isolate()->factory()->the_hole_value());
+    __ j(equal, &copy_hole, Label::kNear);
+    __ push(edx);
+    __ add(eax, Immediate(Smi::FromInt(1)));
+    __ bind(&copy_entry);
+    __ cmp(eax, ecx);
+    __ j(not_equal, &copy_loop, Label::kNear);
+    __ jmp(&invoke);
+
+    // Drop the elements copied so far and start over with keyed loads.
+    __ bind(&copy_hole);
+    __ lea(esp, Operand(esp, eax, times_half_pointer_size, 0));
+
+    __ bind(&slow_copy);
     __ mov(ecx, Operand(ebp, kIndexOffset));
     __ jmp(&entry);
     __ bind(&loop);
@@ -1042,6 +1081,7 @@ void Builtins::Generate_FunctionApply(MacroAssembler* masm) {
     __ j(not_equal, &loop);
 
     // Call the function.
+    __ bind(&invoke);
     Label call_proxy;
     __ mov(eax, ecx);
     ParameterCount actual(eax);
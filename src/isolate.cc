@@ -29,6 +29,7 @@
 
 #include "v8.h"
 
+#include "api.h"
 #include "ast.h"
 #include "bootstrapper.h"
 #include "codegen.h"
@@ -444,6 +445,9 @@ Handle<JSArray> Isolate::CaptureSimpleStackTrace(Handle<JSObject> error_object,
   int frames_seen = 0;
   int sloppy_frames = 0;
   bool encountered_strict_function = false;
+  // Set initial size to the maximum inlining level + 1 for the outermost
+  // function. The list is reused for every frame.
+  List<FrameSummary> frames(FLAG_max_inlining_levels + 1);
   for (StackFrameIterator iter(this);
        !iter.done() && frames_seen < limit;
        iter.Advance()) {
@@ -451,9 +455,7 @@ Handle<JSArray> Isolate::CaptureSimpleStackTrace(Handle<JSObject> error_object,
     if (IsVisibleInStackTrace(raw_frame, *caller, &seen_caller)) {
       frames_seen++;
       JavaScriptFrame* frame = JavaScriptFrame::cast(raw_frame);
-      // Set initial size to the maximum inlining level + 1 for the outermost
-      // function.
-      List<FrameSummary> frames(FLAG_max_inlining_levels + 1);
+      frames.Rewind(0);
       frame->Summarize(&frames);
       for (int i = frames.length() - 1; i >= 0; i--) {
         if (cursor + 4 > elements->length()) {
@@ -2290,4 +2292,86 @@ Handle<JSObject> Isolate::GetSymbolRegistry() {
 }
 
 
+void Isolate::EnqueueMicrotask(Handle<Object> microtask) {
+  ASSERT(microtask->IsJSFunction() || microtask->IsCallHandlerInfo());
+  Handle<FixedArray> queue(heap()->microtask_queue(), this);
+  int num_tasks = pending_microtask_count();
+  int capacity = queue->length();
+  ASSERT(num_tasks <= capacity);
+  if (num_tasks == capacity) {
+    // Unwrap the ring into a buffer twice the size.
+    int start = microtask_queue_start();
+    Handle<FixedArray> new_queue = factory()->NewFixedArray(
+        Max(kMinMicrotaskQueueCapacity, capacity * 2));
+    for (int i = 0; i < num_tasks; i++) {
+      new_queue->set(i, queue->get((start + i) & (capacity - 1)));
+    }
+    heap()->set_microtask_queue(*new_queue);
+    set_microtask_queue_start(0);
+    queue = new_queue;
+    capacity = new_queue->length();
+  }
+  ASSERT(IsPowerOf2(capacity));
+  queue->set((microtask_queue_start() + num_tasks) & (capacity - 1),
+             *microtask);
+  set_pending_microtask_count(num_tasks + 1);
+}
+
+
+void Isolate::RunMicrotasks() {
+  while (pending_microtask_count() > 0) {
+    HandleScope scope(this);
+    // Reload the queue on every iteration since a microtask may have
+    // grown it.
+    FixedArray* queue = heap()->microtask_queue();
+    int start = microtask_queue_start();
+    Handle<Object> microtask(queue->get(start), this);
+    queue->set_undefined(start);
+    set_microtask_queue_start((start + 1) & (queue->length() - 1));
+    set_pending_microtask_count(pending_microtask_count() - 1);
+
+    if (microtask->IsJSFunction()) {
+      Handle<JSFunction> function = Handle<JSFunction>::cast(microtask);
+      // Run the microtask in the native context it was created in.
+      SaveContext save(this);
+      set_context(function->context()->native_context());
+      bool threw = false;
+      Handle<Object> exception = Execution::TryCall(
+          function, factory()->undefined_value(), 0, NULL, &threw);
+      if (threw) {
+        if (*exception == heap()->termination_exception()) {
+          // Execution is terminating, drop the remaining microtasks.
+          heap()->set_microtask_queue(heap()->empty_fixed_array());
+          set_microtask_queue_start(0);
+          set_pending_microtask_count(0);
+          return;
+        }
+        // Nothing can catch an exception thrown by a microtask, so report it
+        // to the message listeners as uncaught.
+        Handle<Object> args[] = { exception };
+        Handle<Object> message = MessageHandler::MakeMessageObject(
+            this, "uncaught_exception", NULL,
+            HandleVector<Object>(args, ARRAY_SIZE(args)), Handle<JSArray>());
+        set_pending_exception(*exception);
+        MessageHandler::ReportMessage(this, NULL, message);
+        clear_pending_exception();
+      }
+    } else {
+      Handle<CallHandlerInfo> callback_info =
+          Handle<CallHandlerInfo>::cast(microtask);
+      v8::MicrotaskCallback callback =
+          v8::ToCData<v8::MicrotaskCallback>(callback_info->callback());
+      void* data = v8::ToCData<void*>(callback_info->data());
+      callback(data);
+    }
+  }
+
+  set_microtask_queue_start(0);
+  int capacity = heap()->microtask_queue()->length();
+  if (capacity > kMaxRetainedMicrotaskQueueCapacity) {
+    heap()->set_microtask_queue(heap()->empty_fixed_array());
+  }
+}
+
+
 } }  // namespace v8::internal
@@ -411,7 +411,9 @@ typedef List<HeapObject*> DebugObjectCache;
   /* AstNode state. */                                                         \
   V(int, ast_node_id, 0)                                                       \
   V(unsigned, ast_node_count, 0)                                               \
-  V(bool, microtask_pending, false)                                            \
+  /* Microtask queue state, see EnqueueMicrotask(). */                         \
+  V(int, pending_microtask_count, 0)                                           \
+  V(int, microtask_queue_start, 0)                                             \
   V(bool, autorun_microtasks, true)                                            \
   V(HStatistics*, hstatistics, NULL)                                           \
   V(HTracer*, htracer, NULL)                                                   \
@@ -1174,9 +1176,23 @@ class Isolate {
   // Get (and lazily initialize) the registry for per-isolate symbols.
   Handle<JSObject> GetSymbolRegistry();
 
+  // Appends a JSFunction or a CallHandlerInfo wrapping a C++ callback to the
+  // microtask queue. The queue is a ring buffer kept in the microtask_queue
+  // heap root, so draining it never reallocates.
+  void EnqueueMicrotask(Handle<Object> microtask);
+
+  // Runs microtasks in FIFO order until the queue is empty, including the
+  // ones enqueued while draining.
+  void RunMicrotasks();
+
  private:
   Isolate();
 
+  static const int kMinMicrotaskQueueCapacity = 8;
+  // A drained queue larger than this is released instead of being kept
+  // around for the next burst.
+  static const int kMaxRetainedMicrotaskQueueCapacity = 4 * KB;
+
   friend struct GlobalState;
   friend struct InitializeGlobalState;
 
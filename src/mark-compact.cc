@@ -1909,7 +1909,7 @@ class StringTableCleaner : public ObjectVisitor {
           !Marking::MarkBitFrom(HeapObject::cast(o)).Get()) {
         if (finalize_external_strings) {
           ASSERT(o->IsExternalString());
-          heap_->FinalizeExternalString(String::cast(*p));
+          heap_->external_string_table()->QueueForDisposal(String::cast(*p));
         } else {
           pointers_removed_++;
         }
@@ -2461,9 +2461,12 @@ void MarkCompactCollector::AfterMarking() {
   string_table->IterateElements(&internalized_visitor);
   string_table->ElementsRemoved(internalized_visitor.PointersRemoved());
 
-  ExternalStringTableCleaner external_visitor(heap());
-  heap()->external_string_table_.Iterate(&external_visitor);
-  heap()->external_string_table_.CleanUp();
+  { GCTracer::Scope gc_scope(tracer_,
+                             GCTracer::Scope::MC_EXTERNAL_STRING_TABLE);
+    ExternalStringTableCleaner external_visitor(heap());
+    heap()->external_string_table_.Iterate(&external_visitor);
+    heap()->external_string_table_.CleanUp();
+  }
 
   // Process the weak references.
   MarkCompactWeakObjectRetainer mark_compact_object_retainer;
@@ -3619,9 +3622,18 @@ void MarkCompactCollector::EvacuateNewSpaceAndCandidates() {
     table->Rehash(heap_->undefined_value());
   }
 
-  // Update pointers from external string table.
-  heap_->UpdateReferencesInExternalStringTable(
-      &UpdateReferenceInExternalStringTableEntry);
+  // Update pointers from external string table. Old space strings can only
+  // have moved if evacuation candidates were selected for this cycle.
+  { GCTracer::Scope gc_scope(tracer_,
+                             GCTracer::Scope::MC_EXTERNAL_STRING_TABLE);
+    if (compacting_) {
+      heap_->UpdateReferencesInExternalStringTable(
+          &UpdateReferenceInExternalStringTableEntry);
+    } else {
+      heap_->UpdateNewSpaceReferencesInExternalStringTable(
+          &UpdateReferenceInExternalStringTableEntry);
+    }
+  }
 
   EvacuationWeakObjectRetainer evacuation_object_retainer;
   heap()->ProcessWeakReferences(&evacuation_object_retainer);
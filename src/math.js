@@ -170,14 +170,15 @@ function MathPow(x, y) {
 
 // ECMA 262 - 15.8.2.14
 var rngstate;  // Initialized to a Uint32Array during genesis.
+var rngcache;  // Initialized to a Float64Array during genesis.
+var rngcache_index = 0;
 function MathRandom() {
-  var r0 = (MathImul(18273, rngstate[0] & 0xFFFF) + (rngstate[0] >>> 16)) | 0;
-  rngstate[0] = r0;
-  var r1 = (MathImul(36969, rngstate[1] & 0xFFFF) + (rngstate[1] >>> 16)) | 0;
-  rngstate[1] = r1;
-  var x = ((r0 << 16) + (r1 & 0xFFFF)) | 0;
-  // Division by 0x100000000 through multiplication by reciprocal.
-  return (x < 0 ? (x + 0x100000000) : x) * 2.3283064365386962890625e-10;
+  // Random numbers are generated by xorshift128+ in batches, so the common
+  // case is a plain typed array load.
+  if (rngcache_index == 0) {
+    rngcache_index = %GenerateRandomNumbers(rngstate, rngcache);
+  }
+  return rngcache[--rngcache_index];
 }
 
 // ECMA 262 - 15.8.2.15
@@ -1145,6 +1145,48 @@ function GetTypeName(receiver, requireConstructor) {
 }
 
 
+// The raw stack trace and the error string captured by captureStackTrace are
+// kept under private symbols on the holder of the 'stack' accessors, so that
+// all errors share the same getter and setter instead of allocating a pair of
+// closures for every error that is created.
+var StackTraceKey = NEW_PRIVATE("Error#stack_trace");
+var StackTraceErrorStringKey = NEW_PRIVATE("Error#error_string");
+
+function StackTraceGetter() {
+  // The holder of this getter may not be the receiver. The first time the
+  // getter is called on a holder, the raw stack trace is formatted and the
+  // accessor pair is turned into a data property (on the holder).
+  var holder = this;
+  while (IS_SPEC_OBJECT(holder) && !%HasLocalProperty(holder, StackTraceKey)) {
+    holder = %GetPrototype(holder);
+  }
+  if (!IS_SPEC_OBJECT(holder)) return UNDEFINED;
+  var stack = GET_PRIVATE(holder, StackTraceKey);
+  if (IS_UNDEFINED(stack)) return UNDEFINED;
+  var error_string = GET_PRIVATE(holder, StackTraceErrorStringKey);
+  var result = FormatStackTrace(holder, error_string, GetStackFrames(stack));
+  // Turn this accessor into a data property.
+  %DefineOrRedefineDataProperty(holder, 'stack', result, NONE);
+  // Release the raw stack trace.
+  SET_PRIVATE(holder, StackTraceKey, UNDEFINED);
+  SET_PRIVATE(holder, StackTraceErrorStringKey, UNDEFINED);
+  return result;
+}
+
+
+// Set the 'stack' property on the receiver.  If the receiver is the same as
+// holder of this setter, the accessor pair is turned into a data property.
+function StackTraceSetter(v) {
+  // Set data property on the receiver (not necessarily holder).
+  %DefineOrRedefineDataProperty(this, 'stack', v, NONE);
+  if (%HasLocalProperty(this, StackTraceKey)) {
+    // Release the raw stack trace if holder is the same as the receiver.
+    SET_PRIVATE(this, StackTraceKey, UNDEFINED);
+    SET_PRIVATE(this, StackTraceErrorStringKey, UNDEFINED);
+  }
+}
+
+
 function captureStackTrace(obj, cons_opt) {
   var stackTraceLimit = $Error.stackTraceLimit;
   if (!stackTraceLimit || !IS_NUMBER(stackTraceLimit)) return;
@@ -1154,34 +1196,10 @@ function captureStackTrace(obj, cons_opt) {
   var stack = %CollectStackTrace(obj,
                                  cons_opt ? cons_opt : captureStackTrace,
                                  stackTraceLimit);
-
-  var error_string = FormatErrorString(obj);
-  // The holder of this getter ('obj') may not be the receiver ('this').
-  // When this getter is called the first time, we use the context values to
-  // format a stack trace string and turn this accessor pair into a data
-  // property (on the holder).
-  var getter = function() {
-    // Stack is still a raw array awaiting to be formatted.
-    var result = FormatStackTrace(obj, error_string, GetStackFrames(stack));
-    // Turn this accessor into a data property.
-    %DefineOrRedefineDataProperty(obj, 'stack', result, NONE);
-    // Release context values.
-    stack = error_string = UNDEFINED;
-    return result;
-  };
-
-  // Set the 'stack' property on the receiver.  If the receiver is the same as
-  // holder of this setter, the accessor pair is turned into a data property.
-  var setter = function(v) {
-    // Set data property on the receiver (not necessarily holder).
-    %DefineOrRedefineDataProperty(this, 'stack', v, NONE);
-    if (this === obj) {
-      // Release context values if holder is the same as the receiver.
-      stack = error_string = UNDEFINED;
-    }
-  };
-
-  %DefineOrRedefineAccessorProperty(obj, 'stack', getter, setter, DONT_ENUM);
+  SET_PRIVATE(obj, StackTraceKey, stack);
+  SET_PRIVATE(obj, StackTraceErrorStringKey, FormatErrorString(obj));
+  %DefineOrRedefineAccessorProperty(
+      obj, 'stack', StackTraceGetter, StackTraceSetter, DONT_ENUM);
 }
 
 
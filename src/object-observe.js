@@ -317,6 +317,30 @@ function ObjectInfoHasActiveObservers(objectInfo) {
   return false;
 }
 
+// Returns true if an active observer of the object accepts change records of
+// the given type. Internal change records are only allocated once this holds.
+function ObjectInfoHasActiveObserverForType(objectInfo, type) {
+  if (IS_UNDEFINED(objectInfo) || !objectInfo.changeObservers)
+    return false;
+
+  if (ChangeObserversIsOptimized(objectInfo.changeObservers)) {
+    var observer = objectInfo.changeObservers;
+    return TypeMapHasType(ObserverGetAcceptTypes(observer), type) &&
+           ObserverIsActive(observer, objectInfo);
+  }
+
+  for (var priority in objectInfo.changeObservers) {
+    var observer = objectInfo.changeObservers[priority];
+    if (!IS_NULL(observer) &&
+        TypeMapHasType(ObserverGetAcceptTypes(observer), type) &&
+        ObserverIsActive(observer, objectInfo)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 function ObjectInfoAddPerformingType(objectInfo, type) {
   objectInfo.performing = objectInfo.performing || TypeMapCreate();
   TypeMapAddType(objectInfo.performing, type);
@@ -438,8 +462,7 @@ function ObserverEnqueueIfActive(observer, objectInfo, changeRecord,
   var callbackInfo = CallbackInfoNormalize(callback);
   if (IS_NULL(GetPendingObservers())) {
     SetPendingObservers(nullProtoObject())
-    GetMicrotaskQueue().push(ObserveMicrotaskRunner);
-    %SetMicrotaskPending(true);
+    %EnqueueMicrotask(ObserveMicrotaskRunner);
   }
   GetPendingObservers()[callbackInfo.priority] = callback;
   callbackInfo.push(changeRecord);
@@ -503,7 +526,7 @@ function EndPerformSplice(array) {
 
 function EnqueueSpliceRecord(array, index, removed, addedCount) {
   var objectInfo = ObjectInfoGet(array);
-  if (!ObjectInfoHasActiveObservers(objectInfo))
+  if (!ObjectInfoHasActiveObserverForType(objectInfo, 'splice'))
     return;
 
   var changeRecord = {
@@ -521,7 +544,7 @@ function EnqueueSpliceRecord(array, index, removed, addedCount) {
 
 function NotifyChange(type, object, name, oldValue) {
   var objectInfo = ObjectInfoGet(object);
-  if (!ObjectInfoHasActiveObservers(objectInfo))
+  if (!ObjectInfoHasActiveObserverForType(objectInfo, type))
     return;
 
   var changeRecord;
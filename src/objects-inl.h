@@ -5372,6 +5372,10 @@ BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, dont_optimize,
 BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, dont_inline, kDontInline)
 BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, dont_cache, kDontCache)
 BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, dont_flush, kDontFlush)
+BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, startup_profile_checked,
+               kStartupProfileChecked)
+BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, in_startup_profile,
+               kInStartupProfile)
 BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, is_generator, kIsGenerator)
 
 void SharedFunctionInfo::BeforeVisitingPointers() {
@@ -1070,7 +1070,12 @@ Object* Object::GetHash() {
   // The object is either a number, a name, an odd-ball,
   // a real JS object, or a Harmony proxy.
   if (IsNumber()) {
-    uint32_t hash = ComputeLongHash(double_to_uint64(Number()));
+    // Numbers with a Smi value hash like that Smi, so optimized code can
+    // hash Smi keys with 32-bit arithmetic.
+    Object* smi;
+    uint32_t hash = ToSmi()->ToObject(&smi)
+        ? ComputeIntegerHash(Smi::cast(smi)->value(), kZeroHashSeed)
+        : ComputeLongHash(double_to_uint64(Number()));
     return Smi::FromInt(hash & Smi::kMaxValue);
   }
   if (IsName()) {
@@ -2213,7 +2218,8 @@ MaybeHandle<Object> JSObject::AddProperty(
   if (object->map()->is_observed() &&
       *name != isolate->heap()->hidden_string()) {
     Handle<Object> old_value = isolate->factory()->the_hole_value();
-    EnqueueChangeRecord(object, "add", name, old_value);
+    EnqueueChangeRecord(object, isolate->factory()->add_string(), name,
+                        old_value);
   }
 
   return value;
@@ -2221,12 +2227,11 @@ MaybeHandle<Object> JSObject::AddProperty(
 
 
 void JSObject::EnqueueChangeRecord(Handle<JSObject> object,
-                                   const char* type_str,
+                                   Handle<String> type,
                                    Handle<Name> name,
                                    Handle<Object> old_value) {
   Isolate* isolate = object->GetIsolate();
   HandleScope scope(isolate);
-  Handle<String> type = isolate->factory()->InternalizeUtf8String(type_str);
   if (object->IsJSGlobalObject()) {
     object = handle(JSGlobalObject::cast(*object)->global_receiver(), isolate);
   }
@@ -4193,7 +4198,8 @@ MaybeHandle<Object> JSObject::SetPropertyForResult(
 
   if (is_observed) {
     if (lookup->IsTransition()) {
-      EnqueueChangeRecord(object, "add", name, old_value);
+      EnqueueChangeRecord(object, isolate->factory()->add_string(), name,
+                          old_value);
     } else {
       LookupResult new_lookup(isolate);
       object->LocalLookup(*name, &new_lookup, true);
@@ -4201,7 +4207,8 @@ MaybeHandle<Object> JSObject::SetPropertyForResult(
         Handle<Object> new_value = Object::GetPropertyOrElement(object, name);
         CHECK_NOT_EMPTY_HANDLE(isolate, new_value);
         if (!new_value->SameValue(*old_value)) {
-          EnqueueChangeRecord(object, "update", name, old_value);
+          EnqueueChangeRecord(object, isolate->factory()->update_string(), name,
+                              old_value);
         }
       }
     }
@@ -4318,9 +4325,11 @@ MaybeHandle<Object> JSObject::SetLocalPropertyIgnoreAttributes(
 
   if (is_observed) {
     if (lookup.IsTransition()) {
-      EnqueueChangeRecord(object, "add", name, old_value);
+      EnqueueChangeRecord(object, isolate->factory()->add_string(), name,
+                          old_value);
     } else if (old_value->IsTheHole()) {
-      EnqueueChangeRecord(object, "reconfigure", name, old_value);
+      EnqueueChangeRecord(object, isolate->factory()->reconfigure_string(),
+                          name, old_value);
     } else {
       LookupResult new_lookup(isolate);
       object->LocalLookup(*name, &new_lookup, true);
@@ -4332,9 +4341,11 @@ MaybeHandle<Object> JSObject::SetLocalPropertyIgnoreAttributes(
       }
       if (new_lookup.GetAttributes() != old_attributes) {
         if (!value_changed) old_value = isolate->factory()->the_hole_value();
-        EnqueueChangeRecord(object, "reconfigure", name, old_value);
+        EnqueueChangeRecord(object, isolate->factory()->reconfigure_string(),
+                            name, old_value);
       } else if (value_changed) {
-        EnqueueChangeRecord(object, "update", name, old_value);
+        EnqueueChangeRecord(object, isolate->factory()->update_string(), name,
+                            old_value);
       }
     }
   }
@@ -5269,7 +5280,8 @@ Handle<Object> JSObject::DeleteElement(Handle<JSObject> object,
 
   if (should_enqueue_change_record && !HasLocalElement(object, index)) {
     Handle<String> name = factory->Uint32ToString(index);
-    EnqueueChangeRecord(object, "delete", name, old_value);
+    EnqueueChangeRecord(object, isolate->factory()->delete_string(), name,
+                        old_value);
   }
 
   return result;
@@ -5345,7 +5357,8 @@ Handle<Object> JSObject::DeleteProperty(Handle<JSObject> object,
   }
 
   if (is_observed && !HasLocalProperty(object, name)) {
-    EnqueueChangeRecord(object, "delete", name, old_value);
+    EnqueueChangeRecord(object, isolate->factory()->delete_string(), name,
+                        old_value);
   }
 
   return result;
@@ -5560,7 +5573,8 @@ Handle<Object> JSObject::PreventExtensions(Handle<JSObject> object) {
   ASSERT(!object->map()->is_extensible());
 
   if (object->map()->is_observed()) {
-    EnqueueChangeRecord(object, "preventExtensions", Handle<Name>(),
+    EnqueueChangeRecord(object, isolate->factory()->preventExtensions_string(),
+                        Handle<Name>(),
                         isolate->factory()->the_hole_value());
   }
   return object;
@@ -6453,7 +6467,8 @@ void JSObject::DefineAccessor(Handle<JSObject> object,
   }
 
   if (is_observed) {
-    const char* type = preexists ? "reconfigure" : "add";
+    Handle<String> type = preexists ? isolate->factory()->reconfigure_string()
+                                    : isolate->factory()->add_string();
     EnqueueChangeRecord(object, type, name, old_value);
   }
 }
@@ -11251,6 +11266,46 @@ void Code::Disassemble(const char* name, FILE* out) {
 #endif  // ENABLE_DISASSEMBLER
 
 
+// Backing stores in large object space are allocated with address space
+// reserved behind them, so they can usually grow without being copied.
+static bool ExpandLargeBackingStoreInPlace(Heap* heap,
+                                           FixedArrayBase* elements,
+                                           int new_length) {
+  int old_length = elements->length();
+  if (new_length <= old_length || !heap->lo_space()->Contains(elements)) {
+    return false;
+  }
+  int new_size;
+  if (elements->map() == heap->fixed_array_map()) {
+    new_size = FixedArray::SizeFor(new_length);
+  } else if (elements->map() == heap->fixed_double_array_map()) {
+    new_size = FixedDoubleArray::SizeFor(new_length);
+  } else {
+    return false;
+  }
+  if (!heap->lo_space()->ExpandInPlace(elements, new_size)) return false;
+
+  if (elements->IsFixedArray()) {
+    FixedArray* array = FixedArray::cast(elements);
+    MemsetPointer(array->data_start() + old_length,
+                  heap->the_hole_value(),
+                  new_length - old_length);
+  } else {
+    FixedDoubleArray* array = FixedDoubleArray::cast(elements);
+    for (int i = old_length; i < new_length; i++) array->set_the_hole(i);
+  }
+  int size_delta = new_size - elements->Size();
+  elements->synchronized_set_length(new_length);
+  heap->AdjustLiveBytes(elements->address(), size_delta, Heap::FROM_MUTATOR);
+
+  HeapProfiler* profiler = heap->isolate()->heap_profiler();
+  if (profiler->is_tracking_allocations()) {
+    profiler->UpdateObjectSizeEvent(elements->address(), elements->Size());
+  }
+  return true;
+}
+
+
 Handle<FixedArray> JSObject::SetFastElementsCapacityAndLength(
     Handle<JSObject> object,
     int capacity,
@@ -11259,11 +11314,23 @@ Handle<FixedArray> JSObject::SetFastElementsCapacityAndLength(
   // We should never end in here with a pixel or external array.
   ASSERT(!object->HasExternalArrayElements());
 
-  // Allocate a new fast elements backing store.
-  Handle<FixedArray> new_elements =
-      object->GetIsolate()->factory()->NewUninitializedFixedArray(capacity);
-
   ElementsKind elements_kind = object->GetElementsKind();
+
+  // Grow the existing backing store in place if possible, otherwise allocate
+  // a new fast elements backing store.
+  Handle<FixedArray> new_elements;
+  bool expanded_in_place =
+      IsFastSmiOrObjectElementsKind(elements_kind) &&
+      ExpandLargeBackingStoreInPlace(object->GetHeap(),
+                                     object->elements(),
+                                     capacity);
+  if (expanded_in_place) {
+    new_elements = handle(FixedArray::cast(object->elements()));
+  } else {
+    new_elements =
+        object->GetIsolate()->factory()->NewUninitializedFixedArray(capacity);
+  }
+
   ElementsKind new_elements_kind;
   // The resized array has FAST_*_SMI_ELEMENTS if the capacity mode forces it,
   // or if it's allowed and the old elements array contained only SMIs.
@@ -11284,8 +11351,10 @@ Handle<FixedArray> JSObject::SetFastElementsCapacityAndLength(
     }
   }
   Handle<FixedArrayBase> old_elements(object->elements());
-  ElementsAccessor* accessor = ElementsAccessor::ForKind(new_elements_kind);
-  accessor->CopyElements(object, new_elements, elements_kind);
+  if (!expanded_in_place) {
+    ElementsAccessor* accessor = ElementsAccessor::ForKind(new_elements_kind);
+    accessor->CopyElements(object, new_elements, elements_kind);
+  }
 
   if (elements_kind != SLOPPY_ARGUMENTS_ELEMENTS) {
     Handle<Map> new_map = (new_elements_kind != elements_kind)
@@ -11319,11 +11388,21 @@ void JSObject::SetFastDoubleElementsCapacityAndLength(Handle<JSObject> object,
   // We should never end in here with a pixel or external array.
   ASSERT(!object->HasExternalArrayElements());
 
-  Handle<FixedArrayBase> elems =
-      object->GetIsolate()->factory()->NewFixedDoubleArray(capacity);
-
   ElementsKind elements_kind = object->GetElementsKind();
   CHECK(elements_kind != SLOPPY_ARGUMENTS_ELEMENTS);
+
+  Handle<FixedArrayBase> elems;
+  bool expanded_in_place =
+      IsFastDoubleElementsKind(elements_kind) &&
+      ExpandLargeBackingStoreInPlace(object->GetHeap(),
+                                     object->elements(),
+                                     capacity);
+  if (expanded_in_place) {
+    elems = handle(object->elements());
+  } else {
+    elems = object->GetIsolate()->factory()->NewFixedDoubleArray(capacity);
+  }
+
   ElementsKind new_elements_kind = elements_kind;
   if (IsHoleyElementsKind(elements_kind)) {
     new_elements_kind = FAST_HOLEY_DOUBLE_ELEMENTS;
@@ -11334,8 +11413,11 @@ void JSObject::SetFastDoubleElementsCapacityAndLength(Handle<JSObject> object,
   Handle<Map> new_map = GetElementsTransitionMap(object, new_elements_kind);
 
   Handle<FixedArrayBase> old_elements(object->elements());
-  ElementsAccessor* accessor = ElementsAccessor::ForKind(FAST_DOUBLE_ELEMENTS);
-  accessor->CopyElements(object, elems, elements_kind);
+  if (!expanded_in_place) {
+    ElementsAccessor* accessor =
+        ElementsAccessor::ForKind(FAST_DOUBLE_ELEMENTS);
+    accessor->CopyElements(object, elems, elements_kind);
+  }
 
   JSObject::ValidateElements(object);
   JSObject::SetMapAndElements(object, new_map, elems);
@@ -11491,11 +11573,13 @@ Handle<Object> JSArray::SetElementsLength(Handle<JSArray> array,
     // will be the hole, which instructs EnqueueChangeRecord to elide
     // the "oldValue" property.
     JSObject::EnqueueChangeRecord(
-        array, "delete", isolate->factory()->Uint32ToString(indices[i]),
+        array, isolate->factory()->delete_string(),
+        isolate->factory()->Uint32ToString(indices[i]),
         old_values[i]);
   }
   JSObject::EnqueueChangeRecord(
-      array, "update", isolate->factory()->length_string(),
+      array, isolate->factory()->update_string(),
+      isolate->factory()->length_string(),
       old_length_handle);
 
   EndPerformSplice(array);
@@ -12631,27 +12715,33 @@ MaybeHandle<Object> JSObject::SetElement(Handle<JSObject> object,
       CHECK(new_length_handle->ToArrayIndex(&new_length));
 
       BeginPerformSplice(Handle<JSArray>::cast(object));
-      EnqueueChangeRecord(object, "add", name, old_value);
-      EnqueueChangeRecord(object, "update", isolate->factory()->length_string(),
+      EnqueueChangeRecord(object, isolate->factory()->add_string(), name,
+                          old_value);
+      EnqueueChangeRecord(object, isolate->factory()->update_string(),
+                          isolate->factory()->length_string(),
                           old_length_handle);
       EndPerformSplice(Handle<JSArray>::cast(object));
       Handle<JSArray> deleted = isolate->factory()->NewJSArray(0);
       EnqueueSpliceRecord(Handle<JSArray>::cast(object), old_length, deleted,
                           new_length - old_length);
     } else {
-      EnqueueChangeRecord(object, "add", name, old_value);
+      EnqueueChangeRecord(object, isolate->factory()->add_string(), name,
+                          old_value);
     }
   } else if (old_value->IsTheHole()) {
-    EnqueueChangeRecord(object, "reconfigure", name, old_value);
+    EnqueueChangeRecord(object, isolate->factory()->reconfigure_string(), name,
+                        old_value);
   } else {
     Handle<Object> new_value =
         Object::GetElementNoExceptionThrown(isolate, object, index);
     bool value_changed = !old_value->SameValue(*new_value);
     if (old_attributes != new_attributes) {
       if (!value_changed) old_value = isolate->factory()->the_hole_value();
-      EnqueueChangeRecord(object, "reconfigure", name, old_value);
+      EnqueueChangeRecord(object, isolate->factory()->reconfigure_string(),
+                          name, old_value);
     } else if (value_changed) {
-      EnqueueChangeRecord(object, "update", name, old_value);
+      EnqueueChangeRecord(object, isolate->factory()->update_string(), name,
+                          old_value);
     }
   }
 
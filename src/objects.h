@@ -2777,7 +2777,7 @@ class JSObject: public JSReceiver {
 
   // Enqueue change record for Object.observe. May cause GC.
   static void EnqueueChangeRecord(Handle<JSObject> object,
-                                  const char* type,
+                                  Handle<String> type,
                                   Handle<Name> name,
                                   Handle<Object> old_value);
 
@@ -4359,6 +4359,15 @@ class OrderedHashTable: public FixedArray {
 
   static const int kNotFound = -1;
 
+  // Layout of the table, used by optimized code that probes it directly.
+  static const int kNumberOfBucketsIndex = 0;
+  static const int kNumberOfElementsIndex = kNumberOfBucketsIndex + 1;
+  static const int kNumberOfDeletedElementsIndex = kNumberOfElementsIndex + 1;
+  static const int kHashTableStartIndex = kNumberOfDeletedElementsIndex + 1;
+
+  static const int kEntrySize = entrysize + 1;
+  static const int kChainOffset = entrysize;
+
  private:
   static Handle<Derived> Rehash(Handle<Derived> table, int new_capacity);
 
@@ -4394,14 +4403,6 @@ class OrderedHashTable: public FixedArray {
     return Smi::cast(get(kHashTableStartIndex + bucket))->value();
   }
 
-  static const int kNumberOfBucketsIndex = 0;
-  static const int kNumberOfElementsIndex = kNumberOfBucketsIndex + 1;
-  static const int kNumberOfDeletedElementsIndex = kNumberOfElementsIndex + 1;
-  static const int kHashTableStartIndex = kNumberOfDeletedElementsIndex + 1;
-
-  static const int kEntrySize = entrysize + 1;
-  static const int kChainOffset = entrysize;
-
   static const int kLoadFactor = 2;
   static const int kMaxCapacity =
       (FixedArray::kMaxLength - kHashTableStartIndex)
@@ -4437,12 +4438,12 @@ class OrderedHashMap: public OrderedHashTable<OrderedHashMap, 2> {
       Handle<Object> key,
       Handle<Object> value);
 
+  static const int kValueOffset = 1;
+
  private:
   Object* ValueAt(int entry) {
     return get(EntryToIndex(entry) + kValueOffset);
   }
-
-  static const int kValueOffset = 1;
 };
 
 
@@ -7197,6 +7198,11 @@ class SharedFunctionInfo: public HeapObject {
   // Indicates that this function is a generator.
   DECL_BOOLEAN_ACCESSORS(is_generator)
 
+  // Whether the function has been looked up in the --startup-profile, and
+  // whether it was found there.
+  DECL_BOOLEAN_ACCESSORS(startup_profile_checked)
+  DECL_BOOLEAN_ACCESSORS(in_startup_profile)
+
   // Indicates whether or not the code in the shared function support
   // deoptimization.
   inline bool has_deoptimization_support();
@@ -7410,6 +7416,8 @@ class SharedFunctionInfo: public HeapObject {
     kDontCache,
     kDontFlush,
     kIsGenerator,
+    kStartupProfileChecked,
+    kInStartupProfile,
     kCompilerHintsCount  // Pseudo entry
   };
 
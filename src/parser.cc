@@ -33,9 +33,11 @@
 #include "char-predicates-inl.h"
 #include "codegen.h"
 #include "compiler.h"
+#include "cpu.h"
 #include "messages.h"
 #include "parser.h"
 #include "platform.h"
+#include "platform/condition-variable.h"
 #include "preparser.h"
 #include "runtime.h"
 #include "scanner-character-streams.h"
@@ -4601,12 +4603,13 @@ int ScriptDataImpl::ReadNumber(byte** source) {
 
 
 // Create a Scanner for the preparser to use as input, and preparse the source.
-ScriptDataImpl* PreParserApi::PreParse(Isolate* isolate,
-                                       Utf16CharacterStream* source) {
+// Does not touch the isolate, so it can be used from any thread. Returns NULL
+// if the preparser ran out of stack.
+static ScriptDataImpl* PreParseWithoutIsolate(UnicodeCache* unicode_cache,
+                                              uintptr_t stack_limit,
+                                              Utf16CharacterStream* source) {
   CompleteParserRecorder recorder;
-  HistogramTimerScope timer(isolate->counters()->pre_parse());
-  Scanner scanner(isolate->unicode_cache());
-  intptr_t stack_limit = isolate->stack_guard()->real_climit();
+  Scanner scanner(unicode_cache);
   PreParser preparser(&scanner, &recorder, stack_limit);
   preparser.set_allow_lazy(true);
   preparser.set_allow_generators(FLAG_harmony_generators);
@@ -4615,10 +4618,7 @@ ScriptDataImpl* PreParserApi::PreParse(Isolate* isolate,
   preparser.set_allow_harmony_numeric_literals(FLAG_harmony_numeric_literals);
   scanner.Initialize(source);
   PreParser::PreParseResult result = preparser.PreParseProgram();
-  if (result == PreParser::kPreParseStackOverflow) {
-    isolate->StackOverflow();
-    return NULL;
-  }
+  if (result == PreParser::kPreParseStackOverflow) return NULL;
 
   // Extract the accumulated data from the recorder as a single
   // contiguous vector that we are responsible for disposing.
@@ -4627,6 +4627,142 @@ ScriptDataImpl* PreParserApi::PreParse(Isolate* isolate,
 }
 
 
+ScriptDataImpl* PreParserApi::PreParse(Isolate* isolate,
+                                       Utf16CharacterStream* source) {
+  HistogramTimerScope timer(isolate->counters()->pre_parse());
+  ScriptDataImpl* data = PreParseWithoutIsolate(
+      isolate->unicode_cache(), isolate->stack_guard()->real_climit(), source);
+  if (data == NULL) isolate->StackOverflow();
+  return data;
+}
+
+
+// Work shared by the threads pre-parsing a batch of sources. Each thread
+// claims the next unclaimed source until all of them are taken. The batch
+// only refers to the raw characters of the sources, never to their handles,
+// and is deleted by whichever of the main thread and the tasks releases it
+// last, so the main thread never has to wait for a task that did not start.
+class PreParseBatch {
+ public:
+  PreParseBatch(Vector<Handle<String> > sources,
+                Vector<ScriptDataImpl*> results,
+                int tasks)
+      : one_byte_sources_(NewArray<Vector<const uint8_t> >(sources.length())),
+        two_byte_sources_(NewArray<Vector<const uc16> >(sources.length())),
+        results_(results),
+        count_(sources.length()),
+        next_(0),
+        done_(0),
+        references_(tasks + 1) {
+    for (int i = 0; i < count_; i++) {
+      // The caller flattened the sources and disallows heap allocation
+      // until the batch is done, so the characters do not move.
+      String::FlatContent content = sources[i]->GetFlatContent();
+      ASSERT(content.IsFlat());
+      if (content.IsAscii()) {
+        one_byte_sources_[i] = content.ToOneByteVector();
+      } else {
+        two_byte_sources_[i] = content.ToUC16Vector();
+      }
+    }
+  }
+
+  void PreParseRemaining(UnicodeCache* unicode_cache, uintptr_t stack_limit) {
+    while (true) {
+      int i = NoBarrier_AtomicIncrement(&next_, 1) - 1;
+      if (i >= count_) return;
+      if (two_byte_sources_[i].start() == NULL) {
+        FlatStringUtf16CharacterStream stream(one_byte_sources_[i]);
+        results_[i] = PreParseWithoutIsolate(unicode_cache, stack_limit,
+                                             &stream);
+      } else {
+        FlatStringUtf16CharacterStream stream(two_byte_sources_[i]);
+        results_[i] = PreParseWithoutIsolate(unicode_cache, stack_limit,
+                                             &stream);
+      }
+      LockGuard<Mutex> lock_guard(&mutex_);
+      if (++done_ == count_) all_done_.NotifyOne();
+    }
+  }
+
+  // Waits until every source has been pre-parsed. Only sources that some
+  // thread claimed can be outstanding once the caller ran PreParseRemaining.
+  void WaitForClaimedSources() {
+    LockGuard<Mutex> lock_guard(&mutex_);
+    while (done_ < count_) all_done_.Wait(&mutex_);
+  }
+
+  void Release() {
+    if (Barrier_AtomicIncrement(&references_, -1) == 0) delete this;
+  }
+
+ private:
+  ~PreParseBatch() {
+    DeleteArray(one_byte_sources_);
+    DeleteArray(two_byte_sources_);
+  }
+
+  Vector<const uint8_t>* one_byte_sources_;
+  Vector<const uc16>* two_byte_sources_;
+  Vector<ScriptDataImpl*> results_;
+  int count_;
+  Atomic32 next_;
+  Mutex mutex_;
+  ConditionVariable all_done_;
+  int done_;
+  Atomic32 references_;
+
+  DISALLOW_COPY_AND_ASSIGN(PreParseBatch);
+};
+
+
+class PreParseTask : public v8::Task {
+ public:
+  explicit PreParseTask(PreParseBatch* batch) : batch_(batch) {}
+
+  virtual ~PreParseTask() {}
+
+ private:
+  // Background threads may have much smaller stacks than the main thread.
+  // A source that nests deeper than this is left to the main thread.
+  static const uintptr_t kStackSize = 256 * KB;
+
+  // v8::Task overrides.
+  virtual void Run() V8_OVERRIDE {
+    UnicodeCache unicode_cache;
+    uintptr_t stack_limit =
+        reinterpret_cast<uintptr_t>(&unicode_cache) - kStackSize;
+    batch_->PreParseRemaining(&unicode_cache, stack_limit);
+    batch_->Release();
+  }
+
+  PreParseBatch* batch_;
+
+  DISALLOW_COPY_AND_ASSIGN(PreParseTask);
+};
+
+
+void PreParserApi::PreParseInParallel(Isolate* isolate,
+                                      Vector<Handle<String> > sources,
+                                      Vector<ScriptDataImpl*> results) {
+  ASSERT_EQ(sources.length(), results.length());
+  DisallowHeapAllocation no_allocation;
+  HistogramTimerScope timer(isolate->counters()->pre_parse());
+  int tasks = Min(sources.length(), CPU::NumberOfProcessorsOnline()) - 1;
+  if (tasks < 0) tasks = 0;
+  PreParseBatch* batch = new PreParseBatch(sources, results, tasks);
+  for (int i = 0; i < tasks; i++) {
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        new PreParseTask(batch), v8::Platform::kShortRunningTask);
+  }
+  batch->PreParseRemaining(isolate->unicode_cache(),
+                           isolate->stack_guard()->real_climit());
+  // Tasks that start after this point find no source left to claim.
+  batch->WaitForClaimedSources();
+  batch->Release();
+}
+
+
 bool RegExpParser::ParseRegExp(FlatStringReader* input,
                                bool multiline,
                                RegExpCompileData* result,
@@ -164,6 +164,15 @@ class PreParserApi {
   // the preparser doesn't know about ScriptDataImpl.
   static ScriptDataImpl* PreParse(Isolate* isolate,
                                   Utf16CharacterStream* source);
+
+  // Pre-parse a batch of flat source strings, spreading the work over the
+  // platform's background threads and the calling thread. Stores the
+  // preparse data of sources[i] in results[i], or NULL if it could not be
+  // pre-parsed. The sources are read concurrently, so this does not
+  // allocate on the heap and only returns once every source is done.
+  static void PreParseInParallel(Isolate* isolate,
+                                 Vector<Handle<String> > sources,
+                                 Vector<ScriptDataImpl*> results);
 };
 
 
@@ -769,7 +769,8 @@ static void CheckFastTls(Thread::LocalStorageKey key) {
 #endif  // V8_FAST_TLS_SUPPORTED
 
 
-Thread::LocalStorageKey Thread::CreateThreadLocalKey() {
+Thread::LocalStorageKey Thread::CreateThreadLocalKey(
+    LocalStorageDestructor destructor) {
 #ifdef V8_FAST_TLS_SUPPORTED
   bool check_fast_tls = false;
   if (tls_base_offset_initialized == 0) {
@@ -778,7 +779,7 @@ Thread::LocalStorageKey Thread::CreateThreadLocalKey() {
   }
 #endif
   pthread_key_t key;
-  int result = pthread_key_create(&key, NULL);
+  int result = pthread_key_create(&key, destructor);
   ASSERT_EQ(0, result);
   USE(result);
   LocalStorageKey local_key = PthreadKeyToLocalKey(key);
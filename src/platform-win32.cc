@@ -1488,7 +1488,10 @@ void Thread::Join() {
 }
 
 
-Thread::LocalStorageKey Thread::CreateThreadLocalKey() {
+Thread::LocalStorageKey Thread::CreateThreadLocalKey(
+    LocalStorageDestructor destructor) {
+  // TLS slots have no thread exit hook.
+  USE(destructor);
   DWORD result = TlsAlloc();
   ASSERT(result != TLS_OUT_OF_INDEXES);
   return static_cast<LocalStorageKey>(result);
@@ -565,8 +565,12 @@ class Thread {
   // Abstract method for run handler.
   virtual void Run() = 0;
 
-  // Thread-local storage.
-  static LocalStorageKey CreateThreadLocalKey();
+  // Thread-local storage. A non-NULL |destructor| is called with a thread's
+  // value when the thread exits while that value is not NULL. Windows TLS
+  // slots have no such hook, so there |destructor| is never called.
+  typedef void (*LocalStorageDestructor)(void* value);
+  static LocalStorageKey CreateThreadLocalKey(
+      LocalStorageDestructor destructor = NULL);
   static void DeleteThreadLocalKey(LocalStorageKey key);
   static void* GetThreadLocal(LocalStorageKey key);
   static int GetThreadLocalInt(LocalStorageKey key) {
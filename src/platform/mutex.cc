@@ -46,6 +46,18 @@ static V8_INLINE void InitializeNativeHandle(pthread_mutex_t* mutex) {
   result = pthread_mutex_init(mutex, &attr);
   ASSERT_EQ(0, result);
   result = pthread_mutexattr_destroy(&attr);
+#elif V8_OS_LINUX && V8_LIBC_GLIBC
+  // Use an adaptive mutex, which spins in user space for a while before
+  // sleeping on the futex. Most critical sections shared with the
+  // background threads are short.
+  pthread_mutexattr_t attr;
+  result = pthread_mutexattr_init(&attr);
+  ASSERT_EQ(0, result);
+  result = pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ADAPTIVE_NP);
+  ASSERT_EQ(0, result);
+  result = pthread_mutex_init(mutex, &attr);
+  ASSERT_EQ(0, result);
+  result = pthread_mutexattr_destroy(&attr);
 #else
   // Use a fast mutex (default attributes).
   result = pthread_mutex_init(mutex, NULL);
@@ -30,6 +30,10 @@
 #if V8_OS_MACOSX
 #include <mach/mach_init.h>
 #include <mach/task.h>
+#elif V8_OS_LINUX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 #endif
 
 #include <errno.h>
@@ -93,6 +97,119 @@ bool Semaphore::WaitFor(const TimeDelta& rel_time) {
   }
 }
 
+#elif V8_OS_LINUX
+
+// Number of attempts to take the semaphore in user space before a waiter
+// goes to sleep in the kernel. Hand-offs between the main thread and the
+// compiler, sweeper and profiler threads are usually short enough for the
+// signal to arrive while spinning.
+static const int kSemaphoreSpinCount = 100;
+// Upper bound on the pause instructions issued between two attempts. The
+// pauses double after every failed attempt, which keeps many spinning
+// waiters from hammering the cache line of the counter.
+static const int kSemaphoreMaxPauses = 8;
+
+
+// Tells the CPU that this is a spin-wait loop. This saves power, lets the
+// other hardware thread of the core run, and avoids the memory order
+// mis-speculation penalty when the spin ends.
+static V8_INLINE void SpinPause() {
+#if V8_HOST_ARCH_IA32 || V8_HOST_ARCH_X64
+  __asm__ __volatile__("pause");
+#elif V8_HOST_ARCH_ARM64
+  __asm__ __volatile__("yield");
+#endif
+}
+
+
+static V8_INLINE int FutexWait(volatile Atomic32* address,
+                               Atomic32 value,
+                               const struct timespec* timeout) {
+  return syscall(SYS_futex, address, FUTEX_WAIT_PRIVATE, value, timeout,
+                 NULL, 0);
+}
+
+
+static V8_INLINE void FutexWake(volatile Atomic32* address, int count) {
+  syscall(SYS_futex, address, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+}
+
+
+// Decrements the counter if it is positive. Returns false if the counter
+// was zero.
+static V8_INLINE bool TryDecrement(Semaphore::NativeHandle* handle) {
+  Atomic32 value = Acquire_Load(&handle->value);
+  while (value > 0) {
+    Atomic32 previous =
+        Acquire_CompareAndSwap(&handle->value, value, value - 1);
+    if (previous == value) return true;
+    value = previous;
+  }
+  return false;
+}
+
+
+static V8_INLINE bool SpinDecrement(Semaphore::NativeHandle* handle) {
+  int pauses = 1;
+  for (int i = 0; i < kSemaphoreSpinCount; i++) {
+    if (TryDecrement(handle)) return true;
+    for (int j = 0; j < pauses; j++) SpinPause();
+    if (pauses < kSemaphoreMaxPauses) pauses *= 2;
+  }
+  return false;
+}
+
+
+Semaphore::Semaphore(int count) {
+  ASSERT(count >= 0);
+  native_handle_.value = count;
+  native_handle_.waiters = 0;
+}
+
+
+Semaphore::~Semaphore() {
+  ASSERT_EQ(0, native_handle_.waiters);
+}
+
+
+void Semaphore::Signal() {
+  // The full barrier orders the increment before the load of the waiter
+  // count, pairing with the barrier in Wait(). Either the waiter sees the
+  // new value before it sleeps, or this thread sees the waiter.
+  Barrier_AtomicIncrement(&native_handle_.value, 1);
+  if (Acquire_Load(&native_handle_.waiters) > 0) {
+    FutexWake(&native_handle_.value, 1);
+  }
+}
+
+
+void Semaphore::Wait() {
+  if (SpinDecrement(&native_handle_)) return;
+  while (!TryDecrement(&native_handle_)) {
+    Barrier_AtomicIncrement(&native_handle_.waiters, 1);
+    // Sleeps only if the counter is still zero. Wakeups may be spurious or
+    // stolen by another waiter, so the counter is checked again.
+    FutexWait(&native_handle_.value, 0, NULL);
+    Barrier_AtomicIncrement(&native_handle_.waiters, -1);
+  }
+}
+
+
+bool Semaphore::WaitFor(const TimeDelta& rel_time) {
+  if (SpinDecrement(&native_handle_)) return true;
+  TimeTicks now = TimeTicks::Now();
+  TimeTicks end = now + rel_time;
+  while (!TryDecrement(&native_handle_)) {
+    if (now >= end) return false;  // Timeout.
+    const struct timespec ts = (end - now).ToTimespec();
+    Barrier_AtomicIncrement(&native_handle_.waiters, 1);
+    FutexWait(&native_handle_.value, 0, &ts);
+    Barrier_AtomicIncrement(&native_handle_.waiters, -1);
+    now = TimeTicks::Now();
+  }
+  return true;
+}
+
 #elif V8_OS_POSIX
 
 Semaphore::Semaphore(int count) {
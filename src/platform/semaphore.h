@@ -28,6 +28,7 @@
 #ifndef V8_PLATFORM_SEMAPHORE_H_
 #define V8_PLATFORM_SEMAPHORE_H_
 
+#include "../atomicops.h"
 #include "../lazy-instance.h"
 #if V8_OS_WIN
 #include "../win32-headers.h"
@@ -35,7 +36,7 @@
 
 #if V8_OS_MACOSX
 #include <mach/semaphore.h>  // NOLINT
-#elif V8_OS_POSIX
+#elif V8_OS_POSIX && !V8_OS_LINUX
 #include <semaphore.h>  // NOLINT
 #endif
 
@@ -74,6 +75,14 @@ class Semaphore V8_FINAL {
 
 #if V8_OS_MACOSX
   typedef semaphore_t NativeHandle;
+#elif V8_OS_LINUX
+  // The counter lives in user space and is only touched with atomic
+  // operations; the kernel is entered through futex(2) only when a waiter
+  // has to sleep or a sleeping waiter has to be woken up.
+  struct NativeHandle {
+    Atomic32 value;
+    Atomic32 waiters;
+  };
 #elif V8_OS_POSIX
   typedef sem_t NativeHandle;
 #elif V8_OS_WIN
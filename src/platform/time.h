@@ -338,6 +338,13 @@ class TimeTicks V8_FINAL BASE_EMBEDDED {
   // Returns true if the high-resolution clock is working on this system.
   static bool IsHighResolutionClockWorking();
 
+  // Switches HighResolutionNow() and Now() to the CPU's time stamp counter,
+  // calibrated against the default clock, where the counter is invariant.
+  // Only implemented on x64 Linux.  Returns false, leaving the default clock
+  // in place, if the counter cannot be used.  Must be called before other
+  // threads read the clock.
+  static bool UseTimeStampCounter();
+
   // Returns true if this object has not been initialized.
   bool IsNull() const { return ticks_ == 0; }
 
@@ -64,7 +64,14 @@ char* RegExpStack::ArchiveStack(char* to) {
 
 char* RegExpStack::RestoreStack(char* from) {
   size_t size = sizeof(thread_local_);
-  OS::MemCopy(&thread_local_, reinterpret_cast<void*>(from), size);
+  ThreadLocal restored;
+  OS::MemCopy(&restored, reinterpret_cast<void*>(from), size);
+  // The current buffer, if any, was kept by FreeThreadResources and is not
+  // in use. A thread that had no buffer of its own takes it over.
+  if (restored.memory_size_ > 0) {
+    thread_local_.Free();
+    thread_local_ = restored;
+  }
   return from + size;
 }
 
@@ -77,6 +84,14 @@ void RegExpStack::Reset() {
 }
 
 
+void RegExpStack::FreeThreadResources() {
+  if (thread_local_.memory_size_ > kMinimumStackSize) {
+    thread_local_.Free();
+    EnsureCapacity(kMinimumStackSize);
+  }
+}
+
+
 void RegExpStack::ThreadLocal::Free() {
   if (memory_size_ > 0) {
     DeleteArray(memory_);
@@ -88,7 +88,9 @@ class RegExpStack {
   }
   char* ArchiveStack(char* to);
   char* RestoreStack(char* from);
-  void FreeThreadResources() { thread_local_.Free(); }
+  // Shrinks a grown buffer back to the default size and keeps it around for
+  // the next thread.
+  void FreeThreadResources();
 
  private:
   RegExpStack();
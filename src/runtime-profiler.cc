@@ -74,12 +74,158 @@ static const int kMaxSizeEarlyOpt =
     5 * FullCodeGenerator::kCodeSizeMultiplier;
 
 
+// Returns a key that identifies a function across runs: the name of its
+// script, its position in the script and its own name. Functions of
+// unnamed scripts have no stable identity and get NULL.
+static char* NewFunctionIdentity(SharedFunctionInfo* shared) {
+  if (!shared->script()->IsScript()) return NULL;
+  Object* script_name = Script::cast(shared->script())->name();
+  if (!script_name->IsString()) return NULL;
+  SmartArrayPointer<char> script = String::cast(script_name)->ToCString();
+  SmartArrayPointer<char> name = shared->DebugName()->ToCString();
+  // Room for the position, the separators and the terminator.
+  int length = StrLength(script.get()) + StrLength(name.get()) + 16;
+  char* identity = NewArray<char>(length);
+  OS::SNPrintF(Vector<char>(identity, length), "%s:%d:%s",
+               script.get(), shared->start_position(), name.get());
+  return identity;
+}
+
+
+static bool FunctionIdentityMatch(void* key1, void* key2) {
+  return strcmp(static_cast<const char*>(key1),
+                static_cast<const char*>(key2)) == 0;
+}
+
+
+static uint32_t FunctionIdentityHash(const char* identity) {
+  return StringHasher::HashSequentialString(
+      identity, StrLength(identity), kZeroHashSeed);
+}
+
+
+// Adds the identity to the set, which takes ownership of it.
+static void AddFunctionIdentity(HashMap* set, char* identity) {
+  HashMap::Entry* entry =
+      set->Lookup(identity, FunctionIdentityHash(identity), true);
+  if (entry->value != NULL) {
+    DeleteArray(identity);
+    return;
+  }
+  entry->value = identity;
+}
+
+
+static void DeleteFunctionIdentities(HashMap* set) {
+  for (HashMap::Entry* entry = set->Start();
+       entry != NULL;
+       entry = set->Next(entry)) {
+    DeleteArray(static_cast<char*>(entry->key));
+  }
+  delete set;
+}
+
+
+HashMap* RuntimeProfiler::startup_profile_ = NULL;
+HashMap* RuntimeProfiler::optimized_functions_ = NULL;
+
+// Protects optimized_functions_.
+static LazyMutex optimized_functions_mutex = LAZY_MUTEX_INITIALIZER;
+
+
 RuntimeProfiler::RuntimeProfiler(Isolate* isolate)
     : isolate_(isolate),
       any_ic_changed_(false) {
 }
 
 
+void RuntimeProfiler::InitializeOncePerProcess() {
+  if (FLAG_startup_profile != NULL) ReadStartupProfile();
+  if (FLAG_startup_profile_out != NULL) {
+    optimized_functions_ = new HashMap(FunctionIdentityMatch);
+  }
+}
+
+
+void RuntimeProfiler::TearDown() {
+  if (startup_profile_ != NULL) {
+    DeleteFunctionIdentities(startup_profile_);
+    startup_profile_ = NULL;
+  }
+  if (optimized_functions_ != NULL) {
+    WriteStartupProfile();
+    DeleteFunctionIdentities(optimized_functions_);
+    optimized_functions_ = NULL;
+  }
+}
+
+
+// The profile lists one function identity per line.
+void RuntimeProfiler::ReadStartupProfile() {
+  bool exists;
+  Vector<const char> contents = ReadFile(FLAG_startup_profile, &exists, false);
+  if (!exists) {
+    PrintF("Could not read startup profile %s\n", FLAG_startup_profile);
+    return;
+  }
+  startup_profile_ = new HashMap(FunctionIdentityMatch);
+  int start = 0;
+  for (int i = 0; i <= contents.length(); i++) {
+    if (i < contents.length() && contents[i] != '\n') continue;
+    int length = i - start;
+    if (length > 0) {
+      char* identity = NewArray<char>(length + 1);
+      OS::MemCopy(identity, contents.start() + start, length);
+      identity[length] = '\0';
+      AddFunctionIdentity(startup_profile_, identity);
+    }
+    start = i + 1;
+  }
+  contents.Dispose();
+}
+
+
+void RuntimeProfiler::WriteStartupProfile() {
+  FILE* file = OS::FOpen(FLAG_startup_profile_out, "w");
+  if (file == NULL) {
+    PrintF("Could not write startup profile %s\n", FLAG_startup_profile_out);
+    return;
+  }
+  for (HashMap::Entry* entry = optimized_functions_->Start();
+       entry != NULL;
+       entry = optimized_functions_->Next(entry)) {
+    fputs(static_cast<const char*>(entry->key), file);
+    fputc('\n', file);
+  }
+  fclose(file);
+}
+
+
+// The result is cached on the function, so the identity is built at most
+// once per function rather than on every tick.
+bool RuntimeProfiler::IsInStartupProfile(SharedFunctionInfo* shared) {
+  if (startup_profile_ == NULL) return false;
+  if (!shared->startup_profile_checked()) {
+    shared->set_startup_profile_checked(true);
+    char* identity = NewFunctionIdentity(shared);
+    if (identity != NULL) {
+      shared->set_in_startup_profile(startup_profile_->Lookup(
+          identity, FunctionIdentityHash(identity), false) != NULL);
+      DeleteArray(identity);
+    }
+  }
+  return shared->in_startup_profile();
+}
+
+
+void RuntimeProfiler::RecordOptimizedFunction(SharedFunctionInfo* shared) {
+  char* identity = NewFunctionIdentity(shared);
+  if (identity == NULL) return;
+  LockGuard<Mutex> lock_guard(optimized_functions_mutex.Pointer());
+  AddFunctionIdentity(optimized_functions_, identity);
+}
+
+
 static void GetICCounts(Code* shared_code,
                         int* ic_with_type_info_count,
                         int* ic_total_count,
@@ -98,9 +244,18 @@ static void GetICCounts(Code* shared_code,
 }
 
 
+static bool HasEnoughTypeInfo(Code* shared_code) {
+  int typeinfo, total, percentage;
+  GetICCounts(shared_code, &typeinfo, &total, &percentage);
+  return percentage >= FLAG_type_info_threshold;
+}
+
+
 void RuntimeProfiler::Optimize(JSFunction* function, const char* reason) {
   ASSERT(function->IsOptimizable());
 
+  if (optimized_functions_ != NULL) RecordOptimizedFunction(function->shared());
+
   if (FLAG_trace_opt && function->PassesFilter(FLAG_hydrogen_filter)) {
     PrintF("[marking ");
     function->ShortPrint();
@@ -270,6 +425,11 @@ void RuntimeProfiler::OptimizeNow() {
       // If no IC was patched since the last tick and this function is very
       // small, optimistically optimize it now.
       Optimize(function, "small function");
+    } else if (!any_ic_changed_ && IsInStartupProfile(shared) &&
+               HasEnoughTypeInfo(shared_code)) {
+      // The function was hot in an earlier run. Optimize it as soon as its
+      // type feedback has settled instead of waiting for more ticks.
+      Optimize(function, "in startup profile");
     } else {
       shared_code->set_profiler_ticks(ticks + 1);
     }
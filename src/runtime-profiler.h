@@ -30,6 +30,7 @@
 
 #include "allocation.h"
 #include "atomicops.h"
+#include "hashmap.h"
 
 namespace v8 {
 namespace internal {
@@ -38,11 +39,18 @@ class Isolate;
 class JSFunction;
 class Object;
 class Semaphore;
+class SharedFunctionInfo;
 
 class RuntimeProfiler {
  public:
   explicit RuntimeProfiler(Isolate* isolate);
 
+  // The startup profile files are shared by all isolates. The profile is
+  // read once per process, and the optimized functions of all isolates are
+  // written when V8 is torn down.
+  static void InitializeOncePerProcess();
+  static void TearDown();
+
   void OptimizeNow();
 
   void NotifyICChanged() { any_ic_changed_ = true; }
@@ -54,9 +62,20 @@ class RuntimeProfiler {
 
   bool CodeSizeOKForOSR(Code* shared_code);
 
+  static void ReadStartupProfile();
+  static void WriteStartupProfile();
+  static bool IsInStartupProfile(SharedFunctionInfo* shared);
+  static void RecordOptimizedFunction(SharedFunctionInfo* shared);
+
   Isolate* isolate_;
 
   bool any_ic_changed_;
+
+  // Functions read from --startup-profile, and functions optimized so far
+  // by any isolate for --startup-profile-out. NULL unless the flag is given.
+  // The startup profile is not modified after it has been read.
+  static HashMap* startup_profile_;
+  static HashMap* optimized_functions_;
 };
 
 } }  // namespace v8::internal
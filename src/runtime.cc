@@ -34,6 +34,7 @@
 #include "allocation-site-scopes.h"
 #include "api.h"
 #include "arguments.h"
+#include "array-buffer-allocator.h"
 #include "bootstrapper.h"
 #include "codegen.h"
 #include "compilation-cache.h"
@@ -755,6 +756,17 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_Fix) {
 }
 
 
+// Returns the external memory an isolate is charged for a backing store of
+// |length| bytes. The built-in allocator hands out whole size classes and
+// pages; other allocators are taken at their word.
+static size_t ArrayBufferChargedSize(size_t length) {
+  if (PoolingArrayBufferAllocator::IsInstance(V8::ArrayBufferAllocator())) {
+    return PoolingArrayBufferAllocator::ChargedSize(length);
+  }
+  return length;
+}
+
+
 void Runtime::FreeArrayBuffer(Isolate* isolate,
                               JSArrayBuffer* phantom_array_buffer) {
   if (phantom_array_buffer->should_be_freed()) {
@@ -767,7 +779,7 @@ void Runtime::FreeArrayBuffer(Isolate* isolate,
       isolate, phantom_array_buffer->byte_length());
 
   isolate->heap()->AdjustAmountOfExternalAllocatedMemory(
-      -static_cast<int64_t>(allocated_length));
+      -static_cast<int64_t>(ArrayBufferChargedSize(allocated_length)));
   CHECK(V8::ArrayBufferAllocator() != NULL);
   V8::ArrayBufferAllocator()->Free(
       phantom_array_buffer->backing_store(),
@@ -821,7 +833,8 @@ bool Runtime::SetupArrayBufferAllocatingData(
 
   SetupArrayBuffer(isolate, array_buffer, false, data, allocated_length);
 
-  isolate->heap()->AdjustAmountOfExternalAllocatedMemory(allocated_length);
+  isolate->heap()->AdjustAmountOfExternalAllocatedMemory(
+      ArrayBufferChargedSize(allocated_length));
 
   return true;
 }
@@ -1507,31 +1520,67 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_SetInitialize) {
   HandleScope scope(isolate);
   ASSERT(args.length() == 1);
   CONVERT_ARG_HANDLE_CHECKED(JSSet, holder, 0);
-  Handle<ObjectHashSet> table = isolate->factory()->NewObjectHashSet(0);
+  Handle<OrderedHashSet> table = isolate->factory()->NewOrderedHashSet();
   holder->set_table(*table);
   return *holder;
 }
 
 
+// Keys are stored with Smi-valued numbers as Smis. Strings are stored
+// internalized if an equal internalized string already exists or the string
+// is short enough to be cheap to internalize, and as they are otherwise.
+// Optimized code finds Smi and internalized string keys by pointer
+// comparison and leaves the lookup to the runtime when it meets a string
+// that is not internalized (see
+// HOptimizedGraphBuilder::BuildJSCollectionLookup).
+static const int kMaxInternalizedCollectionKeyLength = 16;
+
+
+static Handle<Object> CanonicalizeCollectionKey(Isolate* isolate,
+                                                Handle<Object> key) {
+  if (key->IsString()) {
+    Handle<String> string = Handle<String>::cast(key);
+    if (string->IsInternalizedString()) return string;
+    if (string->length() <= kMaxInternalizedCollectionKeyLength) {
+      return isolate->factory()->InternalizeString(string);
+    }
+    String* internalized;
+    if (isolate->heap()->InternalizeStringIfExists(*string, &internalized)) {
+      return Handle<Object>(internalized, isolate);
+    }
+    return string;
+  }
+  if (key->IsHeapNumber()) {
+    double value = HeapNumber::cast(*key)->value();
+    if (IsInt32Double(value) && Smi::IsValid(FastD2I(value))) {
+      return Handle<Object>(Smi::FromInt(FastD2I(value)), isolate);
+    }
+  }
+  return key;
+}
+
+
 RUNTIME_FUNCTION(MaybeObject*, Runtime_SetAdd) {
   HandleScope scope(isolate);
   ASSERT(args.length() == 2);
   CONVERT_ARG_HANDLE_CHECKED(JSSet, holder, 0);
-  Handle<Object> key(args[1], isolate);
-  Handle<ObjectHashSet> table(ObjectHashSet::cast(holder->table()));
-  table = ObjectHashSet::Add(table, key);
+  Handle<Object> key =
+      CanonicalizeCollectionKey(isolate, Handle<Object>(args[1], isolate));
+  Handle<OrderedHashSet> table(OrderedHashSet::cast(holder->table()));
+  table = OrderedHashSet::Add(table, key);
   holder->set_table(*table);
   return isolate->heap()->undefined_value();
 }
 
 
+// The lookups below never allocate, so they work on raw pointers and avoid
+// setting up a HandleScope on every call.
 RUNTIME_FUNCTION(MaybeObject*, Runtime_SetHas) {
-  HandleScope scope(isolate);
+  SealHandleScope shs(isolate);
   ASSERT(args.length() == 2);
-  CONVERT_ARG_HANDLE_CHECKED(JSSet, holder, 0);
-  Handle<Object> key(args[1], isolate);
-  Handle<ObjectHashSet> table(ObjectHashSet::cast(holder->table()));
-  return isolate->heap()->ToBoolean(table->Contains(*key));
+  CONVERT_ARG_CHECKED(JSSet, holder, 0);
+  OrderedHashSet* table = OrderedHashSet::cast(holder->table());
+  return isolate->heap()->ToBoolean(table->Contains(args[1]));
 }
 
 
@@ -1540,18 +1589,19 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_SetDelete) {
   ASSERT(args.length() == 2);
   CONVERT_ARG_HANDLE_CHECKED(JSSet, holder, 0);
   Handle<Object> key(args[1], isolate);
-  Handle<ObjectHashSet> table(ObjectHashSet::cast(holder->table()));
-  table = ObjectHashSet::Remove(table, key);
+  Handle<OrderedHashSet> table(OrderedHashSet::cast(holder->table()));
+  if (!table->Contains(*key)) return isolate->heap()->false_value();
+  table = OrderedHashSet::Remove(table, key);
   holder->set_table(*table);
-  return isolate->heap()->undefined_value();
+  return isolate->heap()->true_value();
 }
 
 
 RUNTIME_FUNCTION(MaybeObject*, Runtime_SetGetSize) {
-  HandleScope scope(isolate);
+  SealHandleScope shs(isolate);
   ASSERT(args.length() == 1);
-  CONVERT_ARG_HANDLE_CHECKED(JSSet, holder, 0);
-  Handle<ObjectHashSet> table(ObjectHashSet::cast(holder->table()));
+  CONVERT_ARG_CHECKED(JSSet, holder, 0);
+  OrderedHashSet* table = OrderedHashSet::cast(holder->table());
   return Smi::FromInt(table->NumberOfElements());
 }
 
@@ -1560,31 +1610,29 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_MapInitialize) {
   HandleScope scope(isolate);
   ASSERT(args.length() == 1);
   CONVERT_ARG_HANDLE_CHECKED(JSMap, holder, 0);
-  Handle<ObjectHashTable> table = isolate->factory()->NewObjectHashTable(0);
+  Handle<OrderedHashMap> table = isolate->factory()->NewOrderedHashMap();
   holder->set_table(*table);
   return *holder;
 }
 
 
 RUNTIME_FUNCTION(MaybeObject*, Runtime_MapGet) {
-  HandleScope scope(isolate);
+  SealHandleScope shs(isolate);
   ASSERT(args.length() == 2);
-  CONVERT_ARG_HANDLE_CHECKED(JSMap, holder, 0);
-  CONVERT_ARG_HANDLE_CHECKED(Object, key, 1);
-  Handle<ObjectHashTable> table(ObjectHashTable::cast(holder->table()));
-  Handle<Object> lookup(table->Lookup(*key), isolate);
-  return lookup->IsTheHole() ? isolate->heap()->undefined_value() : *lookup;
+  CONVERT_ARG_CHECKED(JSMap, holder, 0);
+  OrderedHashMap* table = OrderedHashMap::cast(holder->table());
+  Object* lookup = table->Lookup(args[1]);
+  return lookup->IsTheHole() ? isolate->heap()->undefined_value() : lookup;
 }
 
 
 RUNTIME_FUNCTION(MaybeObject*, Runtime_MapHas) {
-  HandleScope scope(isolate);
+  SealHandleScope shs(isolate);
   ASSERT(args.length() == 2);
-  CONVERT_ARG_HANDLE_CHECKED(JSMap, holder, 0);
-  CONVERT_ARG_HANDLE_CHECKED(Object, key, 1);
-  Handle<ObjectHashTable> table(ObjectHashTable::cast(holder->table()));
-  Handle<Object> lookup(table->Lookup(*key), isolate);
-  return isolate->heap()->ToBoolean(!lookup->IsTheHole());
+  CONVERT_ARG_CHECKED(JSMap, holder, 0);
+  OrderedHashMap* table = OrderedHashMap::cast(holder->table());
+  return isolate->heap()->ToBoolean(
+      table->FindEntry(args[1]) != OrderedHashMap::kNotFound);
 }
 
 
@@ -1593,12 +1641,13 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_MapDelete) {
   ASSERT(args.length() == 2);
   CONVERT_ARG_HANDLE_CHECKED(JSMap, holder, 0);
   CONVERT_ARG_HANDLE_CHECKED(Object, key, 1);
-  Handle<ObjectHashTable> table(ObjectHashTable::cast(holder->table()));
-  Handle<Object> lookup(table->Lookup(*key), isolate);
-  Handle<ObjectHashTable> new_table =
-      ObjectHashTable::Put(table, key, isolate->factory()->the_hole_value());
-  holder->set_table(*new_table);
-  return isolate->heap()->ToBoolean(!lookup->IsTheHole());
+  Handle<OrderedHashMap> table(OrderedHashMap::cast(holder->table()));
+  if (table->FindEntry(*key) == OrderedHashMap::kNotFound) {
+    return isolate->heap()->false_value();
+  }
+  table = OrderedHashMap::Put(table, key, isolate->factory()->the_hole_value());
+  holder->set_table(*table);
+  return isolate->heap()->true_value();
 }
 
 
@@ -1608,18 +1657,19 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_MapSet) {
   CONVERT_ARG_HANDLE_CHECKED(JSMap, holder, 0);
   CONVERT_ARG_HANDLE_CHECKED(Object, key, 1);
   CONVERT_ARG_HANDLE_CHECKED(Object, value, 2);
-  Handle<ObjectHashTable> table(ObjectHashTable::cast(holder->table()));
-  Handle<ObjectHashTable> new_table = ObjectHashTable::Put(table, key, value);
-  holder->set_table(*new_table);
+  key = CanonicalizeCollectionKey(isolate, key);
+  Handle<OrderedHashMap> table(OrderedHashMap::cast(holder->table()));
+  table = OrderedHashMap::Put(table, key, value);
+  holder->set_table(*table);
   return isolate->heap()->undefined_value();
 }
 
 
 RUNTIME_FUNCTION(MaybeObject*, Runtime_MapGetSize) {
-  HandleScope scope(isolate);
+  SealHandleScope shs(isolate);
   ASSERT(args.length() == 1);
-  CONVERT_ARG_HANDLE_CHECKED(JSMap, holder, 0);
-  Handle<ObjectHashTable> table(ObjectHashTable::cast(holder->table()));
+  CONVERT_ARG_CHECKED(JSMap, holder, 0);
+  OrderedHashMap* table = OrderedHashMap::cast(holder->table());
   return Smi::FromInt(table->NumberOfElements());
 }
 
@@ -1761,7 +1811,8 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_SetPrototype) {
     Handle<Object> new_value(
         GetPrototypeSkipHiddenPrototypes(isolate, *obj), isolate);
     if (!new_value->SameValue(*old_value)) {
-      JSObject::EnqueueChangeRecord(obj, "setPrototype",
+      JSObject::EnqueueChangeRecord(obj,
+                                    isolate->factory()->setPrototype_string(),
                                     isolate->factory()->proto_string(),
                                     old_value);
     }
@@ -7904,6 +7955,52 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_MathFround) {
 }
 
 
+// Refills the per-context cache of random numbers used by Math.random with
+// xorshift128+ and returns the number of values in the cache. The state is a
+// Uint32Array holding the two 64-bit words of the generator.
+RUNTIME_FUNCTION(MaybeObject*, Runtime_GenerateRandomNumbers) {
+  SealHandleScope shs(isolate);
+  ASSERT(args.length() == 2);
+  CONVERT_ARG_CHECKED(JSTypedArray, state_array, 0);
+  CONVERT_ARG_CHECKED(JSTypedArray, cache_array, 1);
+  RUNTIME_ASSERT(state_array->type() == kExternalUint32Array);
+  RUNTIME_ASSERT(NumberToSize(isolate, state_array->length()) == 4);
+  RUNTIME_ASSERT(cache_array->type() == kExternalFloat64Array);
+
+  JSArrayBuffer* state_buffer = JSArrayBuffer::cast(state_array->buffer());
+  uint32_t* state = reinterpret_cast<uint32_t*>(
+      static_cast<uint8_t*>(state_buffer->backing_store()) +
+      NumberToSize(isolate, state_array->byte_offset()));
+  JSArrayBuffer* cache_buffer = JSArrayBuffer::cast(cache_array->buffer());
+  double* cache = reinterpret_cast<double*>(
+      static_cast<uint8_t*>(cache_buffer->backing_store()) +
+      NumberToSize(isolate, cache_array->byte_offset()));
+  int length = static_cast<int>(NumberToSize(isolate, cache_array->length()));
+
+  uint64_t state0 = (static_cast<uint64_t>(state[1]) << 32) | state[0];
+  uint64_t state1 = (static_cast<uint64_t>(state[3]) << 32) | state[2];
+  for (int i = 0; i < length; i++) {
+    uint64_t s1 = state0;
+    uint64_t s0 = state1;
+    state0 = s0;
+    s1 ^= s1 << 23;
+    s1 ^= s1 >> 17;
+    s1 ^= s0;
+    s1 ^= s0 >> 26;
+    state1 = s1;
+    // Use the upper 52 bits of the sum as the mantissa of a double in
+    // [1, 2) and shift it down to [0, 1).
+    uint64_t bits = ((state0 + state1) >> 12) | V8_UINT64_C(0x3FF0000000000000);
+    cache[i] = BitCast<double>(bits) - 1.0;
+  }
+  state[0] = static_cast<uint32_t>(state0);
+  state[1] = static_cast<uint32_t>(state0 >> 32);
+  state[2] = static_cast<uint32_t>(state1);
+  state[3] = static_cast<uint32_t>(state1 >> 32);
+  return Smi::FromInt(length);
+}
+
+
 RUNTIME_FUNCTION(MaybeObject*, Runtime_DateMakeDay) {
   SealHandleScope shs(isolate);
   ASSERT(args.length() == 2);
@@ -9650,10 +9747,24 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_DateParseString) {
   CONVERT_ARG_HANDLE_CHECKED(String, str, 0);
   CONVERT_ARG_HANDLE_CHECKED(JSArray, output, 1);
 
+  str = String::Flatten(str);
+
+  // Strict ISO date-time strings produce the time value directly.
+  double time;
+  bool is_iso_date_time;
+  {
+    DisallowHeapAllocation no_gc;
+    String::FlatContent str_content = str->GetFlatContent();
+    is_iso_date_time = str_content.IsAscii() &&
+        DateParser::ParseISODateTime(str_content.ToOneByteVector(),
+                                     isolate->date_cache(),
+                                     &time);
+  }
+  if (is_iso_date_time) return *isolate->factory()->NewNumber(time);
+
   JSObject::EnsureCanContainHeapObjectElements(output);
   RUNTIME_ASSERT(output->HasFastObjectElements());
 
-  str = String::Flatten(str);
   DisallowHeapAllocation no_gc;
 
   FixedArray* output_array = FixedArray::cast(output->elements());
@@ -14201,7 +14312,7 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_CreateCollator) {
   CONVERT_ARG_HANDLE_CHECKED(JSObject, options, 1);
   CONVERT_ARG_HANDLE_CHECKED(JSObject, resolved, 2);
 
-  Handle<ObjectTemplateInfo> collator_template = I18N::GetTemplate(isolate);
+  Handle<ObjectTemplateInfo> collator_template = I18N::GetTemplate2(isolate);
 
   // Create an empty object wrapper.
   bool has_pending_exception = false;
@@ -14219,6 +14330,8 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_CreateCollator) {
   if (!collator) return isolate->ThrowIllegalOperation();
 
   local_object->SetInternalField(0, reinterpret_cast<Smi*>(collator));
+  local_object->SetInternalField(1,
+                                 Collator::ComputeAsciiCompareMode(collator));
 
   RETURN_IF_EMPTY_HANDLE(isolate,
       JSObject::SetLocalPropertyIgnoreAttributes(
@@ -14247,6 +14360,12 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_InternalCompare) {
   icu::Collator* collator = Collator::UnpackCollator(isolate, collator_holder);
   if (!collator) return isolate->ThrowIllegalOperation();
 
+  int ascii_result;
+  if (Collator::TryCompareAscii(collator_holder, string1, string2,
+                                &ascii_result)) {
+    return Smi::FromInt(ascii_result);
+  }
+
   v8::String::Value string_value1(v8::Utils::ToLocal(string1));
   v8::String::Value string_value2(v8::Utils::ToLocal(string2));
   const UChar* u_string1 = reinterpret_cast<const UChar*>(*string_value1);
@@ -14888,32 +15007,23 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_SetIsObserved) {
 }
 
 
-RUNTIME_FUNCTION(MaybeObject*, Runtime_SetMicrotaskPending) {
-  SealHandleScope shs(isolate);
+RUNTIME_FUNCTION(MaybeObject*, Runtime_EnqueueMicrotask) {
+  HandleScope scope(isolate);
   ASSERT(args.length() == 1);
-  CONVERT_BOOLEAN_ARG_CHECKED(new_state, 0);
-  bool old_state = isolate->microtask_pending();
-  isolate->set_microtask_pending(new_state);
-  return isolate->heap()->ToBoolean(old_state);
+  CONVERT_ARG_HANDLE_CHECKED(JSFunction, microtask, 0);
+  isolate->EnqueueMicrotask(microtask);
+  return isolate->heap()->undefined_value();
 }
 
 
 RUNTIME_FUNCTION(MaybeObject*, Runtime_RunMicrotasks) {
   HandleScope scope(isolate);
   ASSERT(args.length() == 0);
-  if (isolate->microtask_pending())
-    Execution::RunMicrotasks(isolate);
+  isolate->RunMicrotasks();
   return isolate->heap()->undefined_value();
 }
 
 
-RUNTIME_FUNCTION(MaybeObject*, Runtime_GetMicrotaskState) {
-  SealHandleScope shs(isolate);
-  ASSERT(args.length() == 0);
-  return isolate->heap()->microtask_state();
-}
-
-
 RUNTIME_FUNCTION(MaybeObject*, Runtime_GetObservationState) {
   SealHandleScope shs(isolate);
   ASSERT(args.length() == 0);
@@ -166,6 +166,7 @@ namespace internal {
   F(MathExp, 1, 1) \
   F(RoundNumber, 1, 1) \
   F(MathFround, 1, 1) \
+  F(GenerateRandomNumbers, 2, 1) \
   \
   /* Regular expressions */ \
   F(RegExpCompile, 3, 1) \
@@ -269,7 +270,7 @@ namespace internal {
   F(ObjectFreeze, 1, 1) \
   \
   /* Harmony microtasks */ \
-  F(GetMicrotaskState, 0, 1) \
+  F(EnqueueMicrotask, 1, 1) \
   \
   /* Harmony modules */ \
   F(IsJSModule, 1, 1) \
@@ -296,14 +297,11 @@ namespace internal {
   /* Harmony sets */ \
   F(SetInitialize, 1, 1) \
   F(SetAdd, 2, 1) \
-  F(SetHas, 2, 1) \
   F(SetDelete, 2, 1) \
   F(SetGetSize, 1, 1) \
   \
   /* Harmony maps */ \
   F(MapInitialize, 1, 1) \
-  F(MapGet, 2, 1) \
-  F(MapHas, 2, 1) \
   F(MapDelete, 2, 1) \
   F(MapSet, 3, 1) \
   F(MapGetSize, 1, 1) \
@@ -316,7 +314,6 @@ namespace internal {
   F(WeakCollectionSet, 3, 1) \
   \
   /* Harmony events */ \
-  F(SetMicrotaskPending, 1, 1) \
   F(RunMicrotasks, 0, 1) \
   \
   /* Harmony observe */ \
@@ -703,7 +700,11 @@ namespace internal {
   F(DoubleHi, 1, 1)                                                          \
   F(DoubleLo, 1, 1)                                                          \
   F(MathSqrt, 1, 1)                                                          \
-  F(MathLog, 1, 1)
+  F(MathLog, 1, 1)                                                           \
+  /* Harmony sets and maps */                                                \
+  F(SetHas, 2, 1)                                                            \
+  F(MapGet, 2, 1)                                                            \
+  F(MapHas, 2, 1)
 
 
 //---------------------------------------------------------------------------
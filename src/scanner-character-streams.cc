@@ -152,6 +152,53 @@ unsigned GenericStringUtf16CharacterStream::FillBuffer(unsigned from_pos,
 }
 
 
+// ----------------------------------------------------------------------------
+// FlatStringUtf16CharacterStream
+
+FlatStringUtf16CharacterStream::FlatStringUtf16CharacterStream(
+    Vector<const uint8_t> data)
+    : one_byte_data_(data.start()),
+      two_byte_data_(NULL),
+      length_(data.length()) {
+  pos_ = 0;
+}
+
+
+FlatStringUtf16CharacterStream::FlatStringUtf16CharacterStream(
+    Vector<const uc16> data)
+    : one_byte_data_(NULL),
+      two_byte_data_(data.start()),
+      length_(data.length()) {
+  pos_ = 0;
+}
+
+
+FlatStringUtf16CharacterStream::~FlatStringUtf16CharacterStream() { }
+
+
+unsigned FlatStringUtf16CharacterStream::BufferSeekForward(unsigned delta) {
+  unsigned old_pos = pos_;
+  pos_ = Min(pos_ + delta, length_);
+  ReadBlock();
+  return pos_ - old_pos;
+}
+
+
+unsigned FlatStringUtf16CharacterStream::FillBuffer(unsigned from_pos,
+                                                    unsigned length) {
+  if (from_pos >= length_) return 0;
+  if (from_pos + length > length_) {
+    length = length_ - from_pos;
+  }
+  if (one_byte_data_ != NULL) {
+    CopyChars(buffer_, one_byte_data_ + from_pos, length);
+  } else {
+    CopyChars(buffer_, two_byte_data_ + from_pos, length);
+  }
+  return length;
+}
+
+
 // ----------------------------------------------------------------------------
 // Utf8ToUtf16CharacterStream
 Utf8ToUtf16CharacterStream::Utf8ToUtf16CharacterStream(const byte* data,
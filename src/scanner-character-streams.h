@@ -76,6 +76,26 @@ class GenericStringUtf16CharacterStream: public BufferedUtf16CharacterStream {
 };
 
 
+// Stream over the characters of a flat string, given as a raw one-byte or
+// two-byte buffer. It holds no handles and never touches the heap, so it can
+// be read on a background thread while the heap is not allowed to move the
+// characters.
+class FlatStringUtf16CharacterStream: public BufferedUtf16CharacterStream {
+ public:
+  explicit FlatStringUtf16CharacterStream(Vector<const uint8_t> data);
+  explicit FlatStringUtf16CharacterStream(Vector<const uc16> data);
+  virtual ~FlatStringUtf16CharacterStream();
+
+ protected:
+  virtual unsigned BufferSeekForward(unsigned delta);
+  virtual unsigned FillBuffer(unsigned position, unsigned length);
+
+  const uint8_t* one_byte_data_;
+  const uc16* two_byte_data_;
+  unsigned length_;
+};
+
+
 // Utf16 stream based on a literal UTF-8 string.
 class Utf8ToUtf16CharacterStream: public BufferedUtf16CharacterStream {
  public:
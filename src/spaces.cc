@@ -737,9 +737,10 @@ Page* MemoryAllocator::AllocatePage(intptr_t size,
 
 
 LargePage* MemoryAllocator::AllocateLargePage(intptr_t object_size,
+                                              intptr_t reserve_size,
                                               Space* owner,
                                               Executability executable) {
-  MemoryChunk* chunk = AllocateChunk(object_size,
+  MemoryChunk* chunk = AllocateChunk(reserve_size,
                                      object_size,
                                      executable,
                                      owner);
@@ -2903,11 +2904,15 @@ LargeObjectSpace::LargeObjectSpace(Heap* heap,
       size_(0),
       page_count_(0),
       objects_size_(0),
-      chunk_map_(ComparePointers, 1024) {}
+      chunk_map_(ComparePointers, 1024),
+      retained_pages_(NULL),
+      retained_size_(0) {}
 
 
 bool LargeObjectSpace::SetUp() {
   first_page_ = NULL;
+  retained_pages_ = NULL;
+  retained_size_ = 0;
   size_ = 0;
   maximum_committed_ = 0;
   page_count_ = 0;
@@ -2918,6 +2923,7 @@ bool LargeObjectSpace::SetUp() {
 
 
 void LargeObjectSpace::TearDown() {
+  ReleaseRetainedPages();
   while (first_page_ != NULL) {
     LargePage* page = first_page_;
     first_page_ = first_page_->next_page();
@@ -2945,12 +2951,29 @@ MaybeObject* LargeObjectSpace::AllocateRaw(int object_size,
     return Failure::RetryAfterGC(identity());
   }
 
-  LargePage* page = heap()->isolate()->memory_allocator()->
-      AllocateLargePage(object_size, this, executable);
+  // Reserve address space behind data and pointer objects so that growing
+  // arrays can be expanded in place.  Address space is too scarce for that
+  // on 32-bit hosts.
+  intptr_t reserve_size = object_size;
+#if V8_HOST_ARCH_64_BIT
+  if (executable == NOT_EXECUTABLE) {
+    reserve_size += static_cast<intptr_t>(object_size) / 100 *
+                    FLAG_large_object_headroom;
+  }
+#endif
+
+  LargePage* page = NULL;
+  if (executable == NOT_EXECUTABLE) {
+    page = TakeRetainedPage(object_size, reserve_size);
+  }
+  if (page == NULL) {
+    page = heap()->isolate()->memory_allocator()->
+        AllocateLargePage(object_size, reserve_size, this, executable);
+  }
   if (page == NULL) return Failure::RetryAfterGC(identity());
   ASSERT(page->area_size() >= object_size);
 
-  size_ += static_cast<int>(page->size());
+  size_ += CommittedSizeOf(page);
   objects_size_ += object_size;
   page_count_++;
   page->set_next_page(first_page_);
@@ -2987,6 +3010,110 @@ MaybeObject* LargeObjectSpace::AllocateRaw(int object_size,
 }
 
 
+bool LargeObjectSpace::ExpandInPlace(HeapObject* object, int new_size) {
+  LargePage* page = reinterpret_cast<LargePage*>(
+      MemoryChunk::FromAddress(object->address()));
+  ASSERT(page->owner() == this && page->GetObject() == object);
+  int old_size = object->Size();
+  ASSERT(new_size > old_size);
+  int delta = new_size - old_size;
+
+  if (page->executable() == EXECUTABLE) return false;
+  if (page->area_start() + new_size > page->address() + page->size()) {
+    return false;
+  }
+  if (!heap()->always_allocate() &&
+      heap()->OldGenerationAllocationLimitReached()) {
+    return false;
+  }
+  if (Size() + delta > max_capacity_) return false;
+
+  intptr_t old_committed = CommittedSizeOf(page);
+  if (!page->CommitArea(new_size)) return false;
+  size_ += CommittedSizeOf(page) - old_committed;
+  objects_size_ += delta;
+  if (size_ > maximum_committed_) {
+    maximum_committed_ = size_;
+  }
+  heap()->isolate()->counters()->large_objects_expanded_in_place()->
+      Increment();
+
+  heap()->incremental_marking()->OldSpaceStep(delta);
+  return true;
+}
+
+
+// Only the committed part of a large page counts towards the size of the
+// space; the rest of its reservation is headroom for growing the object.
+intptr_t LargeObjectSpace::CommittedSizeOf(LargePage* page) {
+  if (page->executable() == EXECUTABLE) return page->size();
+  return RoundUp(page->area_end() - page->address(), OS::CommitPageSize());
+}
+
+
+bool LargeObjectSpace::RetainPage(LargePage* page) {
+  if (page->executable() == EXECUTABLE) return false;
+  intptr_t committed = CommittedSizeOf(page);
+  if (retained_size_ + committed >
+      static_cast<intptr_t>(FLAG_retained_large_object_space) * MB) {
+    return false;
+  }
+  page->set_next_page(retained_pages_);
+  retained_pages_ = page;
+  retained_size_ += committed;
+  return true;
+}
+
+
+LargePage* LargeObjectSpace::TakeRetainedPage(int object_size,
+                                              intptr_t reserve_size) {
+  LargePage* previous = NULL;
+  for (LargePage* page = retained_pages_;
+       page != NULL;
+       previous = page, page = page->next_page()) {
+    intptr_t reserved_area = page->address() + page->size() -
+                             page->area_start();
+    // Do not hand out a much bigger reservation than was asked for.
+    if (reserved_area < object_size || reserved_area > 2 * reserve_size) {
+      continue;
+    }
+    if (previous == NULL) {
+      retained_pages_ = page->next_page();
+    } else {
+      previous->set_next_page(page->next_page());
+    }
+    retained_size_ -= CommittedSizeOf(page);
+
+    VirtualMemory reservation;
+    reservation.TakeControl(page->reserved_memory());
+    MemoryChunk* chunk = MemoryChunk::Initialize(heap(),
+                                                 page->address(),
+                                                 page->size(),
+                                                 page->area_start(),
+                                                 page->area_end(),
+                                                 NOT_EXECUTABLE,
+                                                 this);
+    chunk->set_reserved_memory(&reservation);
+    if (!chunk->CommitArea(object_size)) {
+      heap()->isolate()->memory_allocator()->Free(chunk);
+      return NULL;
+    }
+    return LargePage::Initialize(heap(), chunk);
+  }
+  return NULL;
+}
+
+
+void LargeObjectSpace::ReleaseRetainedPages() {
+  while (retained_pages_ != NULL) {
+    LargePage* page = retained_pages_;
+    retained_pages_ = page->next_page();
+    heap()->isolate()->memory_allocator()->Free(page);
+  }
+  retained_size_ = 0;
+}
+
+
 size_t LargeObjectSpace::CommittedPhysicalMemory() {
   if (!VirtualMemory::HasLazyCommits()) return CommittedMemory();
   size_t size = 0;
@@ -3027,6 +3154,9 @@ LargePage* LargeObjectSpace::FindPage(Address a) {
 
 
 void LargeObjectSpace::FreeUnmarkedObjects() {
+  // Pages retained by the previous full GC have not been reused since.
+  ReleaseRetainedPages();
+
   LargePage* previous = NULL;
   LargePage* current = first_page_;
   while (current != NULL) {
@@ -3054,7 +3184,7 @@ void LargeObjectSpace::FreeUnmarkedObjects() {
       // Free the chunk.
       heap()->mark_compact_collector()->ReportDeleteIfNeeded(
           object, heap()->isolate());
-      size_ -= static_cast<int>(page->size());
+      size_ -= CommittedSizeOf(page);
       objects_size_ -= object->Size();
       page_count_--;
 
@@ -3070,8 +3200,9 @@ void LargeObjectSpace::FreeUnmarkedObjects() {
       }
 
       if (is_pointer_object) {
+        heap()->store_buffer()->ReleaseCardTable(page);
         heap()->QueueMemoryChunkForFree(page);
-      } else {
+      } else if (!RetainPage(page)) {
         heap()->isolate()->memory_allocator()->Free(page);
       }
     }
@@ -884,6 +884,7 @@ class LargePage : public MemoryChunk {
   static inline LargePage* Initialize(Heap* heap, MemoryChunk* chunk);
 
   friend class MemoryAllocator;
+  friend class LargeObjectSpace;
 };
 
 STATIC_CHECK(sizeof(LargePage) <= MemoryChunk::kHeaderSize);
@@ -1088,8 +1089,12 @@ class MemoryAllocator {
   Page* AllocatePage(
       intptr_t size, PagedSpace* owner, Executability executable);
 
-  LargePage* AllocateLargePage(
-      intptr_t object_size, Space* owner, Executability executable);
+  // The page is committed up to object_size but reserves reserve_size bytes
+  // of object area, so that the object can later grow in place.
+  LargePage* AllocateLargePage(intptr_t object_size,
+                               intptr_t reserve_size,
+                               Space* owner,
+                               Executability executable);
 
   void Free(MemoryChunk* chunk);
 
@@ -2831,12 +2836,18 @@ class LargeObjectSpace : public Space {
   }
 
   intptr_t CommittedMemory() {
-    return Size();
+    return Size() + retained_size_;
   }
 
   // Approximate amount of physical memory committed for this space.
   size_t CommittedPhysicalMemory();
 
+  // Grows the object on a large page to new_size bytes by committing more of
+  // the address space reserved behind it.  The caller is responsible for
+  // initializing the new part of the object.  Returns false if the page has
+  // no room left or if the old generation should be collected first.
+  bool ExpandInPlace(HeapObject* object, int new_size);
+
   int PageCount() {
     return page_count_;
   }
@@ -2850,7 +2861,8 @@ class LargeObjectSpace : public Space {
   // if such a page doesn't exist.
   LargePage* FindPage(Address a);
 
-  // Frees unmarked objects.
+  // Frees unmarked objects.  Pages of freed data objects are retained for
+  // reuse until the next call.
   void FreeUnmarkedObjects();
 
   // Checks whether a heap object is in this space; O(1).
@@ -2884,6 +2896,14 @@ class LargeObjectSpace : public Space {
   intptr_t objects_size_;  // size of objects
   // Map MemoryChunk::kAlignment-aligned chunks to large pages covering them
   HashMap chunk_map_;
+  // Pages freed by the last full GC that are kept around for reuse.
+  LargePage* retained_pages_;
+  intptr_t retained_size_;
+
+  static intptr_t CommittedSizeOf(LargePage* page);
+  bool RetainPage(LargePage* page);
+  LargePage* TakeRetainedPage(int object_size, intptr_t reserve_size);
+  void ReleaseRetainedPages();
 
   friend class LargeObjectIterator;
 
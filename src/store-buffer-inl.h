@@ -75,6 +75,18 @@ void StoreBuffer::EnterDirectlyIntoStoreBuffer(Address addr) {
 }
 
 
+bool StoreBuffer::MarkCard(Address addr) {
+  for (int i = 0; i < card_table_count_; i++) {
+    CardTable* table = &card_tables_[i];
+    if (addr >= table->start && addr < table->end) {
+      table->cards[(addr - table->start) >> kCardSizeLog2] = 1;
+      return true;
+    }
+  }
+  return false;
+}
+
+
 void StoreBuffer::ClearDeadObject(HeapObject* object) {
   Address& map_field = Memory::Address_at(object->address());
   if (heap_->map_space()->Contains(map_field)) {
@@ -53,7 +53,8 @@ StoreBuffer::StoreBuffer(Heap* heap)
       virtual_memory_(NULL),
       hash_set_1_(NULL),
       hash_set_2_(NULL),
-      hash_sets_are_empty_(true) {
+      hash_sets_are_empty_(true),
+      card_table_count_(0) {
 }
 
 
@@ -65,8 +66,20 @@ void StoreBuffer::SetUp() {
       reinterpret_cast<Address*>(RoundUp(start_as_int, kStoreBufferSize * 2));
   limit_ = start_ + (kStoreBufferSize / kPointerSize);
 
-  old_virtual_memory_ =
-      new VirtualMemory(kOldStoreBufferLength * kPointerSize);
+  // Reserve the old buffer in proportion to the maximum old generation size,
+  // so that big heaps can remember more slots before falling back to scanning
+  // whole pages on scavenge.  Only the first page is committed up front.
+  // The length is a power of two because EnsureSpace() grows the committed
+  // part by doubling.
+  intptr_t old_length = FLAG_max_store_buffer_entries;
+  if (old_length <= 0) {
+    old_length = heap_->MaxOldGenerationSize() / kOldGenerationBytesPerEntry;
+  }
+  old_length = Max(Min(old_length,
+                       static_cast<intptr_t>(kMaxOldStoreBufferLength)),
+                   static_cast<intptr_t>(kOldStoreBufferLength));
+  old_length = RoundUpToPowerOf2(static_cast<uint32_t>(old_length));
+  old_virtual_memory_ = new VirtualMemory(old_length * kPointerSize);
   old_top_ = old_start_ =
       reinterpret_cast<Address*>(old_virtual_memory_->address());
   // Don't know the alignment requirements of the OS, but it is certainly not
@@ -74,9 +87,9 @@ void StoreBuffer::SetUp() {
   ASSERT((reinterpret_cast<uintptr_t>(old_start_) & 0xfff) == 0);
   int initial_length = static_cast<int>(OS::CommitPageSize() / kPointerSize);
   ASSERT(initial_length > 0);
-  ASSERT(initial_length <= kOldStoreBufferLength);
+  ASSERT(initial_length <= old_length);
   old_limit_ = old_start_ + initial_length;
-  old_reserved_limit_ = old_start_ + kOldStoreBufferLength;
+  old_reserved_limit_ = old_start_ + old_length;
 
   CHECK(old_virtual_memory_->Commit(
             reinterpret_cast<void*>(old_start_),
@@ -113,6 +126,10 @@ void StoreBuffer::TearDown() {
   delete old_virtual_memory_;
   delete[] hash_set_1_;
   delete[] hash_set_2_;
+  for (int i = 0; i < card_table_count_; i++) {
+    delete[] card_tables_[i].cards;
+  }
+  card_table_count_ = 0;
   old_start_ = old_top_ = old_limit_ = old_reserved_limit_ = NULL;
   start_ = limit_ = NULL;
   heap_->public_set_store_buffer_top(start_);
@@ -214,6 +231,7 @@ void StoreBuffer::ExemptPopularPages(int prime_sample_step, int threshold) {
     chunk->set_store_buffer_counter(0);
   }
   bool created_new_scan_on_scavenge_pages = false;
+  bool created_new_card_tables = false;
   MemoryChunk* previous_chunk = NULL;
   for (Address* p = old_start_; p < old_top_; p += prime_sample_step) {
     Address addr = *p;
@@ -225,12 +243,19 @@ void StoreBuffer::ExemptPopularPages(int prime_sample_step, int threshold) {
     }
     int old_counter = containing_chunk->store_buffer_counter();
     if (old_counter >= threshold) {
-      containing_chunk->set_scan_on_scavenge(true);
-      created_new_scan_on_scavenge_pages = true;
+      if (StartCardMarking(containing_chunk)) {
+        created_new_card_tables = true;
+      } else {
+        containing_chunk->set_scan_on_scavenge(true);
+        created_new_scan_on_scavenge_pages = true;
+      }
     }
     containing_chunk->set_store_buffer_counter(old_counter + 1);
     previous_chunk = containing_chunk;
   }
+  if (created_new_card_tables) {
+    MoveEntriesToCardTables();
+  }
   if (created_new_scan_on_scavenge_pages) {
     Filter(MemoryChunk::SCAN_ON_SCAVENGE);
   }
@@ -238,6 +263,65 @@ void StoreBuffer::ExemptPopularPages(int prime_sample_step, int threshold) {
 }
 
 
+// A large pointer array that is popular in the store buffer gets a card table
+// instead of the scan_on_scavenge flag.  Its page keeps recording stores
+// through the write barrier, but Compact() folds those stores into cards, so
+// they do not take up room in the old buffer, and a scavenge only visits the
+// dirty cards rather than the whole array.
+bool StoreBuffer::StartCardMarking(MemoryChunk* chunk) {
+  if (HasCardTable(chunk)) return true;
+  if (!FLAG_store_buffer_card_marking) return false;
+  if (card_table_count_ == kMaxCardTables) return false;
+  if (chunk->owner() != heap_->lo_space() || chunk->scan_on_scavenge()) {
+    return false;
+  }
+  ASSERT(reinterpret_cast<LargePage*>(chunk)->GetObject()->IsFixedArray());
+  CardTable* table = &card_tables_[card_table_count_++];
+  table->chunk = chunk;
+  table->start = chunk->area_start();
+  // Cover the whole reservation, the array may still grow in place.
+  table->end = chunk->address() + chunk->size();
+  int card_count = static_cast<int>(
+      (table->end - table->start + kCardSize - 1) >> kCardSizeLog2);
+  table->cards = new uint8_t[card_count];
+  memset(table->cards, 0, card_count);
+  heap_->isolate()->counters()->store_buffer_card_marked_pages()->Increment();
+  return true;
+}
+
+
+bool StoreBuffer::HasCardTable(MemoryChunk* chunk) {
+  for (int i = 0; i < card_table_count_; i++) {
+    if (card_tables_[i].chunk == chunk) return true;
+  }
+  return false;
+}
+
+
+void StoreBuffer::ReleaseCardTable(MemoryChunk* chunk) {
+  for (int i = 0; i < card_table_count_; i++) {
+    if (card_tables_[i].chunk == chunk) {
+      delete[] card_tables_[i].cards;
+      card_tables_[i] = card_tables_[--card_table_count_];
+      return;
+    }
+  }
+}
+
+
+void StoreBuffer::MoveEntriesToCardTables() {
+  Address* new_top = old_start_;
+  for (Address* p = old_start_; p < old_top_; p++) {
+    if (!MarkCard(*p)) *new_top++ = *p;
+  }
+  old_top_ = new_top;
+
+  // Filtering hash sets are inconsistent with the store buffer after this
+  // operation.
+  ClearFilteringHashSets();
+}
+
+
 void StoreBuffer::Filter(int flag) {
   Address* new_top = old_start_;
   MemoryChunk* previous_chunk = NULL;
@@ -330,6 +414,12 @@ bool StoreBuffer::CellIsInStoreBuffer(Address cell_address) {
       return true;
     }
   }
+  for (int i = 0; i < card_table_count_; i++) {
+    CardTable* table = &card_tables_[i];
+    if (cell_address >= table->start && cell_address < table->end) {
+      return table->cards[(cell_address - table->start) >> kCardSizeLog2] != 0;
+    }
+  }
   return false;
 }
 #endif
@@ -612,6 +702,43 @@ void StoreBuffer::IteratePointersInStoreBuffer(
 }
 
 
+void StoreBuffer::IteratePointersInCardTables(
+    ObjectSlotCallback slot_callback,
+    bool clear_maps) {
+  Counters* counters = heap_->isolate()->counters();
+  for (int i = 0; i < card_table_count_; i++) {
+    CardTable* table = &card_tables_[i];
+    HeapObject* array = reinterpret_cast<LargePage*>(table->chunk)->GetObject();
+    Address object_end = array->address() + array->Size();
+    int card_count = static_cast<int>(
+        (object_end - table->start + kCardSize - 1) >> kCardSizeLog2);
+    for (int card = 0; card < card_count; card++) {
+      if (table->cards[card] == 0) continue;
+      counters->store_buffer_scanned_cards()->Increment();
+      Address start = table->start + (card << kCardSizeLog2);
+      Address end = Min(start + kCardSize, object_end);
+      // Slots that still point to new space after the callback keep the card
+      // dirty for the next scavenge instead of being entered into the old
+      // buffer.
+      bool card_is_dirty = false;
+      for (Address slot_address = start;
+           slot_address < end;
+           slot_address += kPointerSize) {
+        Object** slot = reinterpret_cast<Object**>(slot_address);
+        if (heap_->InNewSpace(*slot)) {
+          HeapObject* object = reinterpret_cast<HeapObject*>(*slot);
+          ASSERT(object->IsHeapObject());
+          if (clear_maps) ClearDeadObject(object);
+          slot_callback(reinterpret_cast<HeapObject**>(slot), object);
+          if (heap_->InNewSpace(*slot)) card_is_dirty = true;
+        }
+      }
+      table->cards[card] = card_is_dirty ? 1 : 0;
+    }
+  }
+}
+
+
 void StoreBuffer::IteratePointersToNewSpace(ObjectSlotCallback slot_callback) {
   IteratePointersToNewSpace(slot_callback, false);
 }
@@ -634,6 +761,7 @@ void StoreBuffer::IteratePointersToNewSpace(ObjectSlotCallback slot_callback,
   // but we can't simply figure that out from slot address
   // because slot can belong to a large object.
   IteratePointersInStoreBuffer(slot_callback, clear_maps);
+  IteratePointersInCardTables(slot_callback, clear_maps);
 
   // We are done scanning all the pointers that were in the store buffer, but
   // there may be some pages marked scan_on_scavenge that have pointers to new
@@ -653,6 +781,8 @@ void StoreBuffer::IteratePointersToNewSpace(ObjectSlotCallback slot_callback,
     while ((chunk = it.next()) != NULL) {
       if (chunk->scan_on_scavenge()) {
         chunk->set_scan_on_scavenge(false);
+        heap_->isolate()->counters()->
+            store_buffer_scan_on_scavenge_pages()->Increment();
         if (callback_ != NULL) {
           (*callback_)(heap_, chunk, kStoreBufferScanningPageEvent);
         }
@@ -704,6 +834,8 @@ void StoreBuffer::Compact() {
     ASSERT(!heap_->cell_space()->Contains(*current));
     ASSERT(!heap_->code_space()->Contains(*current));
     ASSERT(!heap_->old_data_space()->Contains(*current));
+    // Stores into card marked arrays only dirty a card.
+    if (card_table_count_ > 0 && MarkCard(*current)) continue;
     uintptr_t int_addr = reinterpret_cast<uintptr_t>(*current);
     // Shift out the last bits including any tags.
     int_addr >>= kPointerSizeLog2;
@@ -37,6 +37,7 @@
 namespace v8 {
 namespace internal {
 
+class MemoryChunk;
 class Page;
 class PagedSpace;
 class StoreBuffer;
@@ -93,8 +94,15 @@ class StoreBuffer {
   static const int kStoreBufferSize = kStoreBufferOverflowBit;
   static const int kStoreBufferLength = kStoreBufferSize / sizeof(Address);
   static const int kOldStoreBufferLength = kStoreBufferLength * 16;
+  static const int kMaxOldStoreBufferLength = kStoreBufferLength * 256;
+  // Number of bytes of old generation per slot reserved in the old buffer
+  // when the old buffer is sized from the maximum old generation size.
+  static const int kOldGenerationBytesPerEntry = 256;
   static const int kHashSetLengthLog2 = 12;
   static const int kHashSetLength = 1 << kHashSetLengthLog2;
+  static const int kCardSizeLog2 = 9;
+  static const int kCardSize = 1 << kCardSizeLog2;
+  static const int kMaxCardTables = 8;
 
   void Compact();
 
@@ -122,6 +130,11 @@ class StoreBuffer {
 
   bool PrepareForIteration();
 
+  // Large pointer arrays that receive too many old-to-new stores are tracked
+  // in a card table instead of being scanned completely on every scavenge.
+  bool HasCardTable(MemoryChunk* chunk);
+  void ReleaseCardTable(MemoryChunk* chunk);
+
 #ifdef DEBUG
   void Clean();
   // Slow, for asserts only.
@@ -164,8 +177,25 @@ class StoreBuffer {
   uintptr_t* hash_set_2_;
   bool hash_sets_are_empty_;
 
+  // One byte per kCardSize bytes of the object area of a large page.  A
+  // non-zero card may contain pointers to new space.
+  struct CardTable {
+    MemoryChunk* chunk;
+    Address start;
+    Address end;
+    uint8_t* cards;
+  };
+  CardTable card_tables_[kMaxCardTables];
+  int card_table_count_;
+
   void ClearFilteringHashSets();
 
+  bool StartCardMarking(MemoryChunk* chunk);
+  inline bool MarkCard(Address addr);
+  void MoveEntriesToCardTables();
+  void IteratePointersInCardTables(ObjectSlotCallback slot_callback,
+                                   bool clear_maps);
+
   bool SpaceAvailable(intptr_t space_needed);
   void Uniq();
   void ExemptPopularPages(int prime_sample_step, int threshold);
@@ -46,13 +46,29 @@ namespace internal {
 
 
 StubCache::StubCache(Isolate* isolate)
-    : isolate_(isolate) { }
+    : tables_(TablesSize()),
+      primary_(NULL),
+      secondary_(NULL),
+      dirty_(false),
+      isolate_(isolate) {
+  // The tables are allocated here, before any code that probes them is
+  // generated or deserialized, so that their addresses never change.
+  if (!tables_.IsReserved() ||
+      !tables_.Commit(tables_.address(), TablesSize(), false)) {
+    V8::FatalProcessOutOfMemory("StubCache::StubCache");
+  }
+  primary_ = reinterpret_cast<Entry*>(tables_.address());
+  secondary_ = primary_ + kPrimaryTableSize;
+}
 
 
 void StubCache::Initialize() {
   ASSERT(IsPowerOf2(kPrimaryTableSize));
   ASSERT(IsPowerOf2(kSecondaryTableSize));
-  Clear();
+  // Freshly committed pages are already zero, i.e. empty, and are left
+  // untouched so that an isolate that never goes megamorphic does not pay
+  // for the tables.
+  ASSERT(!dirty_);
 }
 
 
@@ -82,7 +98,7 @@ Code* StubCache::Set(Name* name, Map* map, Code* code) {
 
   // If the primary entry has useful data in it, we retire it to the
   // secondary cache before overwriting it.
-  if (old_code != isolate_->builtins()->builtin(Builtins::kIllegal)) {
+  if (old_code != NULL) {
     Map* old_map = primary->map;
     Code::Flags old_flags = Code::RemoveTypeFromFlags(old_code->flags());
     int seed = PrimaryOffset(primary->key, old_flags, old_map);
@@ -92,6 +108,7 @@ Code* StubCache::Set(Name* name, Map* map, Code* code) {
   }
 
   // Update primary cache.
+  dirty_ = true;
   primary->key = name;
   primary->value = code;
   primary->map = map;
@@ -419,17 +436,18 @@ Handle<Code> StubCache::ComputeStoreElementPolymorphic(
 
 
 void StubCache::Clear() {
-  Code* empty = isolate_->builtins()->builtin(Builtins::kIllegal);
-  for (int i = 0; i < kPrimaryTableSize; i++) {
-    primary_[i].key = heap()->empty_string();
-    primary_[i].map = NULL;
-    primary_[i].value = empty;
-  }
-  for (int j = 0; j < kSecondaryTableSize; j++) {
-    secondary_[j].key = heap()->empty_string();
-    secondary_[j].map = NULL;
-    secondary_[j].value = empty;
+  // Empty entries have a NULL key, which never matches a name in either the
+  // generated probes or CollectMatchingMaps.
+  if (!dirty_) return;
+  // Hand the pages back to the OS and commit fresh ones at the same address,
+  // which generated code has baked in. The fresh pages read as zero without
+  // being resident, whereas clearing them in place would keep every page of
+  // both tables resident after each full GC.
+  if (!tables_.Uncommit(tables_.address(), TablesSize()) ||
+      !tables_.Commit(tables_.address(), TablesSize(), false)) {
+    V8::FatalProcessOutOfMemory("StubCache::Clear");
   }
+  dirty_ = false;
 }
 
 
@@ -438,6 +456,7 @@ void StubCache::CollectMatchingMaps(SmallMapList* types,
                                     Code::Flags flags,
                                     Handle<Context> native_context,
                                     Zone* zone) {
+  if (!dirty_) return;
   for (int i = 0; i < kPrimaryTableSize; i++) {
     if (primary_[i].key == *name) {
       Map* map = primary_[i].map;
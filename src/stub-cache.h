@@ -273,8 +273,18 @@ class StubCache {
   static const int kSecondaryTableBits = 9;
   static const int kSecondaryTableSize = (1 << kSecondaryTableBits);
 
-  Entry primary_[kPrimaryTableSize];
-  Entry secondary_[kSecondaryTableSize];
+  static size_t TablesSize() {
+    return RoundUp((kPrimaryTableSize + kSecondaryTableSize) * sizeof(Entry),
+                   OS::CommitPageSize());
+  }
+
+  // Both tables live in one block of fresh pages.  An all-zero entry is
+  // empty, so the pages only become resident once entries are written.
+  VirtualMemory tables_;
+  Entry* primary_;
+  Entry* secondary_;
+  // Whether any entry has been written since the last Clear().
+  bool dirty_;
   Isolate* isolate_;
 
   friend class Isolate;
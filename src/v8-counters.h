@@ -159,7 +159,17 @@ namespace internal {
   SC(pc_to_code_cached, V8.PcToCodeCached)                            \
   /* The store-buffer implementation of the write barrier. */         \
   SC(store_buffer_compactions, V8.StoreBufferCompactions)             \
-  SC(store_buffer_overflows, V8.StoreBufferOverflows)
+  SC(store_buffer_overflows, V8.StoreBufferOverflows)                 \
+  SC(store_buffer_scan_on_scavenge_pages,                             \
+     V8.StoreBufferScanOnScavengePages)                               \
+  SC(store_buffer_card_marked_pages, V8.StoreBufferCardMarkedPages)   \
+  SC(store_buffer_scanned_cards, V8.StoreBufferScannedCards)         \
+  /* Large object space. */                                           \
+  SC(large_objects_expanded_in_place, V8.LargeObjectsExpandedInPlace)\
+  /* External strings. */                                             \
+  SC(external_string_table_entries, V8.ExternalStringTableEntries)    \
+  SC(external_string_resources_disposed,                              \
+     V8.ExternalStringResourcesDisposed)
 
 
 #define STATS_COUNTER_LIST_2(SC)                                      \
@@ -101,6 +101,7 @@ void V8::TearDown() {
   isolate->TearDown();
   delete isolate;
 
+  RuntimeProfiler::TearDown();
   Bootstrapper::TearDownExtensions();
   ElementsAccessor::TearDown();
   LOperand::TearDownCaches();
@@ -151,7 +152,7 @@ void V8::RemoveCallCompletedCallback(CallCompletedCallback callback) {
 void V8::FireCallCompletedCallback(Isolate* isolate) {
   bool has_call_completed_callbacks = call_completed_callbacks_ != NULL;
   bool run_microtasks = isolate->autorun_microtasks() &&
-                        isolate->microtask_pending();
+                        isolate->pending_microtask_count() > 0;
   if (!has_call_completed_callbacks && !run_microtasks) return;
 
   HandleScopeImplementer* handle_scope_implementer =
@@ -159,7 +160,7 @@ void V8::FireCallCompletedCallback(Isolate* isolate) {
   if (!handle_scope_implementer->CallDepthIsZero()) return;
   // Fire callbacks.  Increase call depth to prevent recursive callbacks.
   handle_scope_implementer->IncrementCallDepth();
-  if (run_microtasks) Execution::RunMicrotasks(isolate);
+  if (run_microtasks) isolate->RunMicrotasks();
   if (has_call_completed_callbacks) {
     for (int i = 0; i < call_completed_callbacks_->length(); i++) {
       call_completed_callbacks_->at(i)();
@@ -170,7 +171,7 @@ void V8::FireCallCompletedCallback(Isolate* isolate) {
 
 
 void V8::RunMicrotasks(Isolate* isolate) {
-  if (!isolate->microtask_pending())
+  if (isolate->pending_microtask_count() == 0)
     return;
 
   HandleScopeImplementer* handle_scope_implementer =
@@ -179,7 +180,7 @@ void V8::RunMicrotasks(Isolate* isolate) {
 
   // Increase call depth to prevent recursive callbacks.
   handle_scope_implementer->IncrementCallDepth();
-  Execution::RunMicrotasks(isolate);
+  isolate->RunMicrotasks();
   handle_scope_implementer->DecrementCallDepth();
 }
 
@@ -203,8 +204,10 @@ void V8::InitializeOncePerProcessImpl() {
 #endif
   Sampler::SetUp();
   CPU::SetUp();
+  if (FLAG_time_stamp_counter) TimeTicks::UseTimeStampCounter();
   OS::PostSetUp();
   ElementsAccessor::InitializeOncePerProcess();
+  RuntimeProfiler::InitializeOncePerProcess();
   LOperand::SetUpCaches();
   SetUpJSCallerSavedCodeData();
   ExternalReference::SetUp();
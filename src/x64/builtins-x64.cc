@@ -1082,8 +1082,48 @@ void Builtins::Generate_FunctionApply(MacroAssembler* masm) {
     __ bind(&push_receiver);
     __ Push(rbx);
 
-    // Copy all arguments from the array to the stack.
-    Label entry, loop;
+    // Copy all arguments from the array to the stack. Arrays and arguments
+    // objects with fast elements are copied straight from their backing store
+    // unless they contain holes, which need a lookup on the prototype chain.
+    Label entry, loop, slow_copy, check_elements_kind, copy_loop, copy_entry;
+    Label copy_hole, invoke;
+    __ movp(rdx, Operand(rbp, kArgumentsOffset));
+    __ JumpIfSmi(rdx, &slow_copy);
+    __ movp(rcx, FieldOperand(rdx, HeapObject::kMapOffset));
+    __ testb(FieldOperand(rcx, Map::kBitFieldOffset),
+             Immediate((1 << Map::kHasIndexedInterceptor) |
+                       (1 << Map::kIsAccessCheckNeeded)));
+    __ j(not_zero, &slow_copy);
+    __ CmpInstanceType(rcx, JS_ARRAY_TYPE);
+    __ j(equal, &check_elements_kind, Label::kNear);
+    __ CmpInstanceType(rcx, JS_OBJECT_TYPE);
+    __ j(not_equal, &slow_copy);
+    __ bind(&check_elements_kind);
+    __ CheckFastElements(rcx, &slow_copy);
+    __ movp(rcx, FieldOperand(rdx, JSObject::kElementsOffset));
+    __ movp(rax, Operand(rbp, kLimitOffset));
+    __ SmiCompare(rax, FieldOperand(rcx, FixedArray::kLengthOffset));
+    __ j(greater, &slow_copy);
+    __ SmiToInteger64(r8, rax);
+    __ Set(r9, 0);
+    __ jmp(&copy_entry, Label::kNear);
+    __ bind(&copy_loop);
+    __ movp(rdx, FieldOperand(rcx, r9, times_pointer_size,
+                              FixedArray::kHeaderSize));
+    __ CompareRoot(rdx, Heap::kTheHoleValueRootIndex);
+    __ j(equal, &copy_hole, Label::kNear);
+    __ Push(rdx);
+    __ incp(r9);
+    __ bind(&copy_entry);
+    __ cmpp(r9, r8);
+    __ j(not_equal, &copy_loop, Label::kNear);
+    __ jmp(&invoke);
+
+    // Drop the elements copied so far and start over with keyed loads.
+    __ bind(&copy_hole);
+    __ leap(rsp, Operand(rsp, r9, times_pointer_size, 0));
+
+    __ bind(&slow_copy);
     __ movp(rax, Operand(rbp, kIndexOffset));
     __ jmp(&entry);
     __ bind(&loop);
@@ -1111,6 +1151,7 @@ void Builtins::Generate_FunctionApply(MacroAssembler* masm) {
     __ j(not_equal, &loop);
 
     // Call the function.
+    __ bind(&invoke);
     Label call_proxy;
     ParameterCount actual(rax);
     __ SmiToInteger32(rax, rax);